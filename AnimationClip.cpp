@@ -0,0 +1,166 @@
+// AnimationClip.cpp
+#include "AnimationClip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "Log.h"
+
+using json = nlohmann::json;
+
+namespace {
+    // Shortest frame we accept; keeps clip lengths non-zero
+    constexpr float MinFrameTime = 0.001f;
+
+    AnimLoop ParseLoop(const std::string& name) {
+        if (name == "once") return AnimLoop::Once;
+        if (name == "pingpong") return AnimLoop::PingPong;
+        if (name != "loop")
+            LOG_WARN("Unknown animation loop mode '%s', using loop", name.c_str());
+        return AnimLoop::Loop;
+    }
+}
+
+SpriteSheet::SpriteSheet(float sheetWidth, float sheetHeight, int frameCols, int frameRows)
+    : frameCols_(std::max(1, frameCols)), frameRows_(std::max(1, frameRows)) {
+    frameSize_ = { sheetWidth / frameCols_, sheetHeight / frameRows_ };
+
+    glm::vec2 uvSize = { 1.0f / frameCols_, 1.0f / frameRows_ };
+    cellUVs_.reserve(static_cast<std::size_t>(frameCols_) * frameRows_);
+    for (int row = 0; row < frameRows_; ++row)
+        for (int col = 0; col < frameCols_; ++col)
+            cellUVs_.emplace_back(col * uvSize.x, 1.0f - (row + 1) * uvSize.y, uvSize.x, uvSize.y);
+}
+
+std::uint16_t SpriteSheet::AddClip(const std::string& name, int row, int firstCol, int frameCount,
+                                   float frameTime, AnimLoop loop) {
+    return AddClip(name, row, firstCol, std::vector<float>(std::max(1, frameCount), frameTime), loop);
+}
+
+std::uint16_t SpriteSheet::AddClip(const std::string& name, int row, int firstCol,
+                                   const std::vector<float>& durations, AnimLoop loop) {
+    AnimationClip clip;
+    clip.firstFrame = static_cast<std::uint32_t>(frameUVs_.size());
+    clip.loop = loop;
+
+    // Frames run left to right and wrap onto the next row
+    row = std::clamp(row, 0, frameRows_ - 1);
+    int cell = row * frameCols_ + std::clamp(firstCol, 0, frameCols_ - 1);
+    for (float duration : durations) {
+        if (cell >= static_cast<int>(cellUVs_.size())) {
+            LOG_WARN("Animation clip '%s' runs off the sheet; truncated", name.c_str());
+            break;
+        }
+        frameUVs_.push_back(cellUVs_[cell++]);
+        frameDurations_.push_back(std::max(duration, MinFrameTime));
+        clip.length += frameDurations_.back();
+        ++clip.frameCount;
+    }
+    if (clip.frameCount == 0) {
+        // Keep the id valid: a one-frame clip of the first cell
+        frameUVs_.push_back(cellUVs_[0]);
+        frameDurations_.push_back(MinFrameTime);
+        clip.length = MinFrameTime;
+        clip.frameCount = 1;
+    }
+
+    auto it = clipIds_.find(name);
+    if (it != clipIds_.end()) {
+        clips_[it->second] = clip;
+        return it->second;
+    }
+    auto id = static_cast<std::uint16_t>(clips_.size());
+    clips_.push_back(clip);
+    clipIds_[name] = id;
+    return id;
+}
+
+int SpriteSheet::FindClip(const std::string& name) const {
+    auto it = clipIds_.find(name);
+    return it != clipIds_.end() ? it->second : -1;
+}
+
+float SpriteSheet::Advance(std::uint16_t clip, float time, float dt) const {
+    const AnimationClip& c = clips_[clip];
+    time += dt;
+    switch (c.loop) {
+    case AnimLoop::Loop:     return std::fmod(time, c.length);
+    case AnimLoop::Once:     return std::min(time, c.length);
+    case AnimLoop::PingPong: return std::fmod(time, 2.0f * c.length);
+    }
+    return time;
+}
+
+const glm::vec4& SpriteSheet::Sample(std::uint16_t clip, float time) const {
+    const AnimationClip& c = clips_[clip];
+    if (c.loop == AnimLoop::PingPong && time >= c.length)
+        time = 2.0f * c.length - time;
+
+    // Clips are a handful of frames, so a linear walk beats anything cleverer
+    std::uint32_t last = c.firstFrame + c.frameCount - 1;
+    for (std::uint32_t f = c.firstFrame; f < last; ++f) {
+        if (time < frameDurations_[f]) return frameUVs_[f];
+        time -= frameDurations_[f];
+    }
+    return frameUVs_[last];
+}
+
+bool AnimationLibrary::LoadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG_ERROR("❌ Failed to load %s", path.c_str());
+        return false;
+    }
+
+    json data;
+    try {
+        file >> data;
+    } catch (const json::exception& e) {
+        LOG_ERROR("❌ %s: %s", path.c_str(), e.what());
+        return false;
+    }
+
+    sheets_.clear();
+    ids_.clear();
+
+    for (auto& [name, s] : data.items()) {
+        const auto& grid = s["sheet"];
+        SpriteSheet sheet(grid.value("width", 0.0f), grid.value("height", 0.0f),
+                          grid.value("cols", 1), grid.value("rows", 1));
+
+        if (s.contains("clips")) {
+            for (auto& [clipName, c] : s["clips"].items()) {
+                int row = c.value("row", 0);
+                int from = c.value("from", 0);
+                AnimLoop loop = ParseLoop(c.value("loop", "loop"));
+                if (c.contains("durations"))
+                    sheet.AddClip(clipName, row, from, c["durations"].get<std::vector<float>>(), loop);
+                else
+                    sheet.AddClip(clipName, row, from, c.value("frames", 1), c.value("frameTime", 0.1f), loop);
+            }
+        }
+        Register(name, std::move(sheet));
+    }
+
+    LOG_INFO("Loaded %zu sprite sheets from %s", sheets_.size(), path.c_str());
+    return true;
+}
+
+int AnimationLibrary::Register(const std::string& name, SpriteSheet sheet) {
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        sheets_[it->second] = std::move(sheet);
+        return it->second;
+    }
+    int id = static_cast<int>(sheets_.size());
+    sheets_.push_back(std::move(sheet));
+    ids_[name] = id;
+    return id;
+}
+
+int AnimationLibrary::Find(const std::string& name) {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : -1;
+}
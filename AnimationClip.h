@@ -0,0 +1,93 @@
+// AnimationClip.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// What happens when a clip runs past its last frame
+enum class AnimLoop : std::uint8_t {
+	Loop,      // wrap to the first frame
+	Once,      // hold the last frame
+	PingPong,  // play backwards, then forwards again
+};
+
+// A run of frames in a sheet's frame table
+struct AnimationClip {
+	std::uint32_t firstFrame = 0;
+	std::uint32_t frameCount = 0;
+	float length = 0.0f;   // seconds, sum of the frame durations
+	AnimLoop loop = AnimLoop::Loop;
+};
+
+// The frame grid of one texture and the clips cut from it. Every UV rect is
+// computed once here, so entities only keep a clip id and a clip time and
+// never divide by the sheet size while drawing.
+class SpriteSheet {
+public:
+	SpriteSheet() = default;
+	SpriteSheet(float sheetWidth, float sheetHeight, int frameCols, int frameRows);
+
+	// Size of one frame in pixels
+	glm::vec2 GetFrameSize() const { return frameSize_; }
+	int GetFrameCols() const { return frameCols_; }
+	int GetFrameRows() const { return frameRows_; }
+
+	// uvRect (offset.xy, size.zw) of one grid cell; row 0 is the top row
+	const glm::vec4& CellUV(int col, int row) const { return cellUVs_[row * frameCols_ + col]; }
+
+	// frameCount cells of a row starting at firstCol, frameTime seconds each.
+	// Returns the clip id; adding an existing name replaces it.
+	std::uint16_t AddClip(const std::string& name, int row, int firstCol, int frameCount,
+						  float frameTime, AnimLoop loop = AnimLoop::Loop);
+	// Same, with one duration per frame
+	std::uint16_t AddClip(const std::string& name, int row, int firstCol,
+						  const std::vector<float>& durations, AnimLoop loop = AnimLoop::Loop);
+
+	// Clip id for a name, or -1 if unknown
+	int FindClip(const std::string& name) const;
+	const AnimationClip& Clip(std::uint16_t clip) const { return clips_[clip]; }
+	std::size_t ClipCount() const { return clips_.size(); }
+
+	// Moves a clip time on by dt, wrapping (or clamping) into the clip's range
+	// so it never grows without bound
+	float Advance(std::uint16_t clip, float time, float dt) const;
+	// uvRect of the frame showing at time
+	const glm::vec4& Sample(std::uint16_t clip, float time) const;
+
+private:
+	glm::vec2 frameSize_{ 0.0f };
+	int frameCols_ = 1, frameRows_ = 1;
+	std::vector<glm::vec4> cellUVs_;
+
+	// Every clip's frames back to back
+	std::vector<glm::vec4> frameUVs_;
+	std::vector<float> frameDurations_;
+
+	std::vector<AnimationClip> clips_;
+	std::unordered_map<std::string, std::uint16_t> clipIds_;
+};
+
+// Sprite sheets are data: resources/animations.json maps a sheet name to
+// its grid and clips. Built once at startup; entities refer to a sheet by
+// id and never copy its tables.
+class AnimationLibrary {
+public:
+	// Replaces the library with the sheets in a JSON file
+	static bool LoadFromFile(const std::string& path);
+
+	// Adds (or replaces) a sheet; returns its id
+	static int Register(const std::string& name, SpriteSheet sheet);
+
+	// Sheet id for a name, or -1 if unknown
+	static int Find(const std::string& name);
+
+	static const SpriteSheet& Sheet(int id) { return sheets_[id]; }
+
+private:
+	inline static std::vector<SpriteSheet> sheets_;
+	inline static std::unordered_map<std::string, int> ids_;
+};
@@ -0,0 +1,58 @@
+// Camera.cpp
+#include "Camera.h"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void Camera::SetViewport(glm::vec2 size) {
+    viewport_ = size;
+    Clamp();
+    Refresh();
+}
+
+void Camera::SetBounds(glm::vec2 min, glm::vec2 max) {
+    boundsMin_ = min;
+    boundsMax_ = max;
+    hasBounds_ = true;
+    Clamp();
+    Refresh();
+}
+
+void Camera::SnapTo(glm::vec2 target) {
+    center_ = target;
+    Clamp();
+    Refresh();
+}
+
+void Camera::Follow(glm::vec2 target, float dt) {
+    // Only the part of the offset outside the deadzone moves the camera
+    glm::vec2 offset = target - center_;
+    glm::vec2 excess = offset - glm::clamp(offset, -config_.deadzone, config_.deadzone);
+
+    // Frame-rate independent exponential approach
+    float t = config_.smoothing > 0.0f ? 1.0f - std::exp(-config_.smoothing * dt) : 1.0f;
+    center_ += excess * t;
+
+    Clamp();
+    Refresh();
+}
+
+void Camera::Clamp() {
+    if (!hasBounds_) return;
+    glm::vec2 half = viewport_ * 0.5f;
+    for (int axis = 0; axis < 2; ++axis) {
+        float lo = boundsMin_[axis] + half[axis];
+        float hi = boundsMax_[axis] - half[axis];
+        center_[axis] = lo <= hi ? glm::clamp(center_[axis], lo, hi) : (boundsMin_[axis] + boundsMax_[axis]) * 0.5f;
+    }
+}
+
+void Camera::Refresh() {
+    glm::vec2 topLeft = center_ - viewport_ * 0.5f;
+    if (config_.pixelSnap)
+        topLeft = glm::floor(topLeft + 0.5f);
+
+    visible_ = { topLeft, topLeft + viewport_ };
+    viewProjection_ = glm::ortho(visible_.min.x, visible_.max.x, visible_.max.y, visible_.min.y);
+}
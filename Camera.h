@@ -0,0 +1,63 @@
+// Camera.h
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Axis-aligned world rectangle, e.g. what the camera can see
+struct ViewRect {
+	glm::vec2 min{ 0.0f };
+	glm::vec2 max{ 0.0f };
+
+	bool Overlaps(glm::vec2 otherMin, glm::vec2 otherMax) const {
+		return otherMax.x > min.x && otherMin.x < max.x &&
+			   otherMax.y > min.y && otherMin.y < max.y;
+	}
+};
+
+struct CameraConfig {
+	// Half-size of the box around the view centre the target may move in
+	// without dragging the camera
+	glm::vec2 deadzone{ 32.0f, 24.0f };
+	// How fast the camera closes the gap, per second (0 = snap instantly)
+	float smoothing = 8.0f;
+	// Round the view to whole pixels so tiles don't shimmer while scrolling
+	bool pixelSnap = true;
+};
+
+// 2D scrolling camera over a map in world pixels (y down). Follows a target
+// with a deadzone and exponential smoothing, stays inside the map bounds
+// and produces the view-projection for drawing plus the visible rectangle
+// for culling.
+class Camera {
+public:
+	void SetConfig(const CameraConfig& config) { config_ = config; }
+	const CameraConfig& GetConfig() const { return config_; }
+
+	// Size of the view in world pixels (the internal render resolution)
+	void SetViewport(glm::vec2 size);
+	// Map extent to stay inside; smaller than the viewport = centred
+	void SetBounds(glm::vec2 min, glm::vec2 max);
+	void ClearBounds() { hasBounds_ = false; Refresh(); }
+
+	// Jump straight to a target, e.g. after a level load or a teleport
+	void SnapTo(glm::vec2 target);
+	// Call once per update with the target's centre
+	void Follow(glm::vec2 target, float dt);
+
+	glm::vec2 GetCenter() const { return center_; }
+	const glm::mat4& GetViewProjection() const { return viewProjection_; }
+	const ViewRect& GetVisibleRect() const { return visible_; }
+
+private:
+	void Clamp();
+	void Refresh();
+
+	CameraConfig config_;
+	glm::vec2 viewport_{ 0.0f };
+	glm::vec2 center_{ 0.0f };
+	glm::vec2 boundsMin_{ 0.0f }, boundsMax_{ 0.0f };
+	bool hasBounds_ = false;
+
+	ViewRect visible_;
+	glm::mat4 viewProjection_{ 1.0f };
+};
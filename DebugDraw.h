@@ -9,7 +9,8 @@
 void InitDebugDraw();                     // Call once at init
 void DestroyDebugDraw();                  // Cleanup on shutdown
 
-void DrawDebugCircle(const Circle& c, const glm::vec3& color, const glm::mat4& proj, std::shared_ptr<Shader> shader, int segments = 32);
-void DrawDebugGrid(int cols, int rows, int tileWidth, int tileHeight, const glm::mat4& proj, std::shared_ptr<Shader> shader);
+// World space, through the per-frame view-projection
+void DrawDebugCircle(const Circle& c, const glm::vec3& color, std::shared_ptr<Shader> shader, int segments = 32);
+void DrawDebugGrid(int cols, int rows, int tileWidth, int tileHeight, std::shared_ptr<Shader> shader);
 
 #endif // DEBUG_DRAW_H
@@ -1,41 +1,47 @@
 #include "Dog.h"
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
-#include <iostream>
 #include <unordered_set>
 #include <array>
 #include "Collision.h"
-
-unsigned int Dog::quadVAO_ = 0;
-unsigned int Dog::quadVBO_ = 0;
+#include "GLState.h"
+#include "Log.h"
+#include "Stats.h"
+#include "TextureAtlas.h"
 
 Dog::Dog(std::shared_ptr<Shader> shader,
          std::shared_ptr<Texture2D> texture,
          glm::vec2 position,
-         glm::ivec2 frame)
+         int animation)
     : shader_(std::move(shader)), texture_(std::move(texture)),
-      position_(position), frame_(frame)
+      position_(position), animation_(animation)
 {
-    if (quadVAO_ == 0)
-        initRenderData();
-
+    PlayClip("idle");
+    RefreshShape();
 }
 
-void Dog::Draw(const glm::mat4& projection)
+void Dog::RefreshShape()
 {
-    constexpr float sheetWidth = 256.0f;
-    constexpr float sheetHeight = 48.0f;
-    constexpr int frameCols = 16;
-    constexpr int frameRows = 3;
+    size_ = AnimationLibrary::Sheet(animation_).GetFrameSize() * manscale_;
+    boundingCircle_.radius = 0.5f * glm::length(size_) * collisionScale_;
+    RefreshCenter();
+}
 
-    float frameWidth = sheetWidth / frameCols;
-    float frameHeight = sheetHeight / frameRows;
+void Dog::PlayClip(const std::string& name)
+{
+    int clip = AnimationLibrary::Sheet(animation_).FindClip(name);
+    if (clip < 0) {
+        LOG_WARN("[Dog] No clip '%s' in the dog sheet", name.c_str());
+        return;
+    }
+    clip_ = static_cast<std::uint16_t>(clip);
+    animTime_ = 0.0f;
+}
 
-    glm::vec2 uvSize = { frameWidth / sheetWidth, frameHeight / sheetHeight };
-    glm::vec2 uvOffset = {
-        frame_.x * uvSize.x,
-        1.0f - (frame_.y + 1) * uvSize.y
-    };
+void Dog::Submit(RenderQueue& queue, std::uint8_t layer) const
+{
+    const SpriteSheet& sheet = AnimationLibrary::Sheet(animation_);
+    const glm::vec2 size = size_;
 
     //float baseOffsetDeg = 90.0f; // ✅ Use this if your sprite faces up
     // float baseOffsetDeg = 0.0f;  // Use this if it faces right
@@ -44,40 +50,24 @@ void Dog::Draw(const glm::mat4& projection)
 
     float angleDeg = static_cast<float>(facingDirection_) * 45.0f + baseOffsetDeg;    float angleRad = glm::radians(angleDeg);
 
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position_, 0.0f));
-    model = glm::translate(model, glm::vec3(0.5f * frameWidth * manscale_, 0.5f * frameHeight * manscale_, 0.0f));
-    model = glm::rotate(model, angleRad, glm::vec3(0, 0, 1));
-    model = glm::translate(model, glm::vec3(-0.5f * frameWidth * manscale_, -0.5f * frameHeight * manscale_, 0.0f));
-    model = glm::scale(model, glm::vec3(frameWidth * manscale_, frameHeight * manscale_, 1.0f));
-
-    shader_->Use();
-    shader_->SetMatrix4("model", model);
-    shader_->SetMatrix4("projection", projection);
-    shader_->SetVector4f("uvRect", glm::vec4(uvOffset, uvSize));
-
-    texture_->Bind();
-    glBindVertexArray(quadVAO_);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    SpriteCommand cmd;
+    cmd.shader = shader_.get();
+    cmd.texture = texture_.get();
+    cmd.position = position_;
+    cmd.size = size;
+    cmd.rotation = angleRad;   // about the sprite centre
+    cmd.uvRect = RemapUV(region_, sheet.Sample(clip_, animTime_));
+    queue.Submit(RenderQueue::MakeKey(layer, cmd, 0), cmd);
 }
 
 
-// Dog.cpp
-Circle Dog::ComputeBoundingCircle() const {
-    float frameWidth = (256.0f / 16.0f) * manscale_;
-    float frameHeight = (48.0f / 3.0f) * manscale_;
-    float radius = 0.5f * glm::length(glm::vec2(frameWidth, frameHeight)) * collisionScale_;
-    glm::vec2 center = position_ + glm::vec2(frameWidth, frameHeight) * 0.5f;
-    return { center, radius };
-}
-
 void Dog::Update(
     float dt,
     const std::vector<const std::vector<std::vector<int>>*>& mapDataPtrs,
     const std::unordered_set<int>& solidTiles,
     int tileWidth,
     int tileHeight,
-    glm::vec2 screenSize)
+    glm::vec2 mapSize)
 {
     // ─── Begin: handle bite & cooldown timers ───
     // 1) If we're on cooldown (i.e. just finished a bite), reduce that timer:
@@ -94,23 +84,23 @@ void Dog::Update(
             // Bite just finished → enter cooldown
             isBiting_ = false;
             biteCooldown_ = biteCooldownTime_;
-            std::cout << "[Dog] Bite finished; entering cooldown.\n";
+            LOG_DEBUG("[Dog] Bite finished; entering cooldown.");
         }
     }
     // ─── End: bite & cooldown timers ───
 
-    float frameW = (256.0f / 16.0f) * manscale_;
-    float frameH = (48.0f / 3.0f) * manscale_;
-    float radius = 0.5f * glm::length(glm::vec2(frameW, frameH)) * collisionScale_;
-    Circle c = { position_ + glm::vec2(frameW, frameH) * 0.5f, radius };
+    animTime_ = AnimationLibrary::Sheet(animation_).Advance(clip_, animTime_, dt);
 
+    Circle c = boundingCircle_;
 
-    if (!TryMoveCircle(c, velocity_, dt, screenSize, mapDataPtrs, solidTiles, tileWidth, tileHeight)) {
+
+    if (!TryMoveCircle(c, velocity_, dt, mapSize, mapDataPtrs, solidTiles, tileWidth, tileHeight)) {
         velocity_ = glm::vec2(0.0f);
     }
 
     // Back from center to top-left
-    position_ = c.center - glm::vec2(frameW, frameH) * 0.5f;
+    boundingCircle_.center = c.center;
+    position_ = c.center - size_ * 0.5f;
 }
 
 
@@ -125,10 +115,12 @@ glm::vec2 Dog::GetPosition() const {
 
 void Dog::SetPosition(const glm::vec2& pos) {
     position_ = pos;
+    RefreshCenter();
 }
 
 void Dog::SetScale(float scale) {
     manscale_ = scale;
+    RefreshShape();
 }
 
 void Dog::SetVelocity(glm::vec2 v) {
@@ -143,42 +135,17 @@ void Dog::SetVelocity(glm::vec2 v) {
     facingDirection_ = static_cast<Direction8>(static_cast<int>((angle + 22.5f) / 45.0f) % 8);
 }
 
-void Dog::initRenderData()
-{
-    constexpr float vertices[] = {
-        0.0f, 1.0f,  0.0f, 1.0f,
-        1.0f, 0.0f,  1.0f, 0.0f,
-        0.0f, 0.0f,  0.0f, 0.0f,
-        0.0f, 1.0f,  0.0f, 1.0f,
-        1.0f, 1.0f,  1.0f, 1.0f,
-        1.0f, 0.0f,  1.0f, 0.0f
-    };
-
-    glGenVertexArrays(1, &quadVAO_);
-    glGenBuffers(1, &quadVBO_);
-
-    glBindVertexArray(quadVAO_);
-    glBindBuffer(GL_ARRAY_BUFFER, quadVBO_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
 void Dog::SetCollisionScale(float scale) {
     collisionScale_ = scale;
+    RefreshShape();
 }
 void Dog::StartBite() {
     // Only allow a bite if we are not already biting and the cooldown has expired
     if (!isBiting_ && biteCooldown_ <= 0.0f) {
         isBiting_   = true;
         biteTimer_  = biteDuration_;
-        // (You could also switch to a “bite” animation frame here by modifying frame_.x/frame_.y)
-        std::cout << "[Dog] Starting bite!\n";
+        // (A "bite" clip in animations.json could be started here with PlayClip)
+        LOG_DEBUG("[Dog] Starting bite!");
     }
 }
 
@@ -186,7 +153,7 @@ Circle Dog::ComputeBiteCircle() const {
     // We want a small circle in front of the dog’s facing direction:
     // Pick a “bite range” of, say, 0.5 × the dog’s bounding circle radius,
     // and place it one radius‐and‐a‐bit in front of the dog’s center.
-    Circle body = ComputeBoundingCircle();
+    const Circle& body = boundingCircle_;
     float biteRangeFactor = 0.5f;      // bite circle radius = 0.5 × body radius
     float offsetFactor    = 0.75f;     // how far in front of the body center we place it
 
@@ -6,6 +6,7 @@
 #include "shader.h"
 #include "texture.h"
 #include "TileMap.h"
+#include "AnimationClip.h"
 
 #include <memory>
 
@@ -28,12 +29,20 @@ public:
 	Dog(std::shared_ptr<Shader> shader,
 		std::shared_ptr<Texture2D> texture,
 		glm::vec2 position,
-		glm::ivec2 frame);
+		int animation);
 
-	void Draw(const glm::mat4& projection);
+	void Submit(RenderQueue& queue, std::uint8_t layer) const;
 
-	Circle ComputeBoundingCircle() const;
+	// Cached; kept in step with position, scale and collision scale
+	const Circle& GetBoundingCircle() const { return boundingCircle_; }
 	float GetScale() const { return manscale_; }
+	// On-screen sprite size: one sheet frame times the scale
+	glm::vec2 GetSize() const { return size_; }
+
+	// Switches clip (by name in the dog's sheet) and restarts it
+	void PlayClip(const std::string& name);
+	// Where the sheet sits in the texture (an atlas page); whole texture by default
+	void SetTextureRegion(const glm::vec4& region) { region_ = region; }
 
 	void SetScale(float manscale);
 	void Update(
@@ -42,7 +51,7 @@ public:
 	const std::unordered_set<int>& solidTiles,
 	int tileWidth,
 	int tileHeight,
-	glm::vec2 screenSize);
+	glm::vec2 mapSize);
 
 	glm::vec2 GetPosition() const;
 	void SetPosition(const glm::vec2& pos);
@@ -62,22 +71,29 @@ public:
 private:
 	std::shared_ptr<Shader> shader_;
 	std::shared_ptr<Texture2D> texture_;
+	glm::vec4 region_{ 0.0f, 0.0f, 1.0f, 1.0f };
 
 	glm::vec2 position_;
-	glm::ivec2 frame_;
+	int animation_ = 0;          // AnimationLibrary sheet id
+	std::uint16_t clip_ = 0;
+	float animTime_ = 0.0f;
 	float manscale_ = 1.0f;
 	float collisionScale_ = 1.0f;
 	glm::vec2 velocity_ = glm::vec2(0.0f);
 	float speed_ = 150.0f;
 	Direction8 facingDirection_ = Direction8::Down;
-	Circle boundingCircle_;
+
+	// Collision shape cache. RefreshShape() redoes the size and radius (the
+	// sqrt) and runs only when scale or collision scale change; moving just
+	// re-centres the circle.
+	glm::vec2 size_ = glm::vec2(0.0f);
+	Circle boundingCircle_{ glm::vec2(0.0f), 0.0f };
+	void RefreshShape();
+	void RefreshCenter() { boundingCircle_.center = position_ + size_ * 0.5f; }
 
 
 
 
-	static unsigned int quadVAO_;
-	static unsigned int quadVBO_;
-	void initRenderData();
 
 	bool isBiting_       = false;   // true while the bite “animation” is active
 	float biteTimer_     = 0.0f;    // how much longer we remain in the “bite” state
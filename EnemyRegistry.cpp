@@ -1,32 +1,80 @@
 #include "EnemyRegistry.h"
-#include "Enemies.h"
 
-// Internal registry storage
-std::unordered_map<std::string, EnemyConstructor>& EnemyRegistry::GetRegistry() {
-	static std::unordered_map<std::string, EnemyConstructor> registry;
-	return registry;
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+#include "Log.h"
+
+using json = nlohmann::json;
+
+namespace {
+	EnemyBehavior ParseBehavior(const std::string& name) {
+		if (name == "idle") return EnemyBehavior::Idle;
+		if (name == "chase") return EnemyBehavior::Chase;
+		if (name == "swarm") return EnemyBehavior::Swarm;
+		if (name != "patrol")
+			LOG_WARN("Unknown enemy behavior '%s', using patrol", name.c_str());
+		return EnemyBehavior::Patrol;
+	}
 }
 
-// Register enemy type
-void EnemyRegistry::Register(const std::string& type, EnemyConstructor ctor) {
-	GetRegistry()[type] = std::move(ctor);
+bool EnemyRegistry::LoadFromFile(const std::string& path) {
+	std::ifstream file(path);
+	if (!file) {
+		LOG_ERROR("❌ Failed to load %s", path.c_str());
+		return false;
+	}
+
+	json data;
+	try {
+		file >> data;
+	} catch (const json::exception& e) {
+		LOG_ERROR("❌ %s: %s", path.c_str(), e.what());
+		return false;
+	}
+
+	params_.clear();
+	archetypes_.clear();
+	ids_.clear();
+
+	for (auto& [name, e] : data.items()) {
+		EnemyTypeParams params;
+		params.behavior = ParseBehavior(e.value("ai", "patrol"));
+		params.patrolSpeed = e.value("speed", params.patrolSpeed);
+		params.patrolInterval = e.value("patrolInterval", params.patrolInterval);
+		params.chaseRadius = e.value("chaseRadius", params.chaseRadius);
+		params.chaseSpeed = e.value("chaseSpeed", params.chaseSpeed);
+
+		EnemyArchetype archetype;
+		archetype.texture = e.value("texture", name);
+		archetype.shader = e.value("shader", archetype.shader);
+		archetype.animation = e.value("animation", name);
+		archetype.clip = e.value("clip", archetype.clip);
+		archetype.scale = e.value("scale", archetype.scale);
+		archetype.collisionScale = e.value("collisionScale", archetype.collisionScale);
+
+		Register(name, params, archetype);
+	}
+
+	LOG_INFO("Loaded %zu enemy types from %s", params_.size(), path.c_str());
+	return true;
 }
 
-// Create enemy by type
-std::unique_ptr<Enemy> EnemyRegistry::Create(
-	const std::string& type,
-	std::shared_ptr<Shader> shader,
-	std::shared_ptr<Texture2D> texture,
-	glm::vec2 pos, glm::ivec2 frame,
-	float fw, float fh, int frameCols, int frameRows)
-{
-	auto it = GetRegistry().find(type);
-	if (it != GetRegistry().end()) {
-		return it->second(shader, texture, pos, frame, fw, fh, frameCols, frameRows);
+int EnemyRegistry::Register(const std::string& type, const EnemyTypeParams& params, const EnemyArchetype& archetype) {
+	auto it = ids_.find(type);
+	if (it != ids_.end()) {
+		params_[it->second] = params;
+		archetypes_[it->second] = archetype;
+		return it->second;
 	}
-	return nullptr;
+	int id = static_cast<int>(params_.size());
+	params_.push_back(params);
+	archetypes_.push_back(archetype);
+	ids_[type] = id;
+	return id;
 }
 
-// Automatically register enemy types
-REGISTER_ENEMY_TYPE_ALIAS("slime", SlimeEnemy)
-REGISTER_ENEMY_TYPE_ALIAS("skeleton", SkeletonEnemy)
+int EnemyRegistry::Find(const std::string& type) {
+	auto it = ids_.find(type);
+	return it != ids_.end() ? it->second : -1;
+}
@@ -1,39 +1,57 @@
 #pragma once
 
-#include <functional>
-#include <unordered_map>
+#include <cstdint>
 #include <string>
-#include <memory>
-
-#include "Enemy.h"
-
-// Macro for registering enemy types with alias
-#define REGISTER_ENEMY_TYPE_ALIAS(alias, ClassName) \
-namespace { \
-const bool registered_##ClassName = [] { \
-EnemyRegistry::Register(alias, [](std::shared_ptr<Shader> s, std::shared_ptr<Texture2D> t, glm::vec2 p, glm::ivec2 f, float fw, float fh, int fc, int fr) { \
-return std::make_unique<ClassName>(s, t, p, f, fw, fh, fc, fr); \
-}); \
-return true; \
-}(); \
-}
-
-// Constructor type used in registry
-using EnemyConstructor = std::function<std::unique_ptr<Enemy>(
-	std::shared_ptr<Shader>, std::shared_ptr<Texture2D>,
-	glm::vec2, glm::ivec2, float, float, int, int)>;
+#include <unordered_map>
+#include <vector>
+
+// Which AI routine EnemyStore::Update runs for a type
+enum class EnemyBehavior : std::uint8_t {
+	Idle,     // animate in place
+	Patrol,   // wander left/right, re-rolling direction every patrolInterval
+	Chase,    // path towards the dog within chaseRadius, patrol otherwise
+	Swarm,    // follow the level's shared flow field (chaseRadius 0 = any range)
+};
+
+// Per-archetype constants read by the update loops. Every enemy of a type
+// shares one entry, indexed by the type id stored in EnemyStore.
+struct EnemyTypeParams {
+	EnemyBehavior behavior = EnemyBehavior::Patrol;
+	float patrolSpeed = 20.0f;    // pixels per second
+	float patrolInterval = 2.0f;  // seconds between direction changes
+	float chaseRadius = 0.0f;     // pixels; Chase / Swarm
+	float chaseSpeed = 30.0f;     // pixels per second
+};
+
+// Spawn-time defaults; a level's enemy entry may override any of them
+struct EnemyArchetype {
+	std::string texture;
+	std::string shader = "sprite";
+	std::string animation;        // AnimationLibrary sheet name
+	std::string clip = "idle";
+	float scale = 1.0f;
+	float collisionScale = 1.0f;
+};
 
+// Enemy types are data: resources/enemies.json maps a type name to its
+// texture, animation, movement and AI behaviour.
 class EnemyRegistry {
 public:
-	static void Register(const std::string& type, EnemyConstructor ctor);
+	// Replaces the registry with the types in a JSON file
+	static bool LoadFromFile(const std::string& path);
+
+	// Adds (or replaces) a type; returns its type id
+	static int Register(const std::string& type, const EnemyTypeParams& params, const EnemyArchetype& archetype);
+
+	// Type id for a name, or -1 if unknown
+	static int Find(const std::string& type);
 
-	static std::unique_ptr<Enemy> Create(
-		const std::string& type,
-		std::shared_ptr<Shader> shader,
-		std::shared_ptr<Texture2D> texture,
-		glm::vec2 pos, glm::ivec2 frame,
-		float fw, float fh, int frameCols, int frameRows);
+	static const EnemyTypeParams& Params(int typeId) { return params_[typeId]; }
+	static const EnemyArchetype& Archetype(int typeId) { return archetypes_[typeId]; }
+	static const std::vector<EnemyTypeParams>& Table() { return params_; }
 
 private:
-	static std::unordered_map<std::string, EnemyConstructor>& GetRegistry();
+	inline static std::vector<EnemyTypeParams> params_;
+	inline static std::vector<EnemyArchetype> archetypes_;
+	inline static std::unordered_map<std::string, int> ids_;
 };
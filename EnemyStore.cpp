@@ -0,0 +1,375 @@
+// EnemyStore.cpp
+#include "EnemyStore.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "EnemyRegistry.h"
+#include "JobSystem.h"
+#include "GLState.h"
+#include "Stats.h"
+#include "TextureAtlas.h"
+
+std::uint16_t EnemyStore::AddSheet(std::shared_ptr<Shader> shader, std::shared_ptr<Texture2D> texture, int animation,
+                                   glm::vec4 region) {
+    for (std::size_t i = 0; i < sheets_.size(); ++i) {
+        const EnemySheet& s = sheets_[i];
+        if (s.shader == shader && s.texture == texture && s.animation == animation && s.region == region)
+            return static_cast<std::uint16_t>(i);
+    }
+    sheets_.push_back({ std::move(shader), std::move(texture), animation, region });
+    return static_cast<std::uint16_t>(sheets_.size() - 1);
+}
+
+void EnemyStore::Reserve(std::size_t capacity) {
+    ForEachArray(*this, [capacity](auto& v) { v.reserve(capacity); });
+    slots_.reserve(capacity);
+    freeSlots_.reserve(capacity);
+}
+
+EnemyHandle EnemyStore::Spawn(int typeId, std::uint16_t sheet, glm::vec2 position, std::uint16_t clip,
+                              float scale, float collisionScale, const Rng& rng) {
+    glm::vec2 size = AnimationLibrary::Sheet(sheets_[sheet].animation).GetFrameSize() * scale;
+    float width = size.x, height = size.y;
+
+    auto dense = static_cast<std::uint32_t>(Size());
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.push_back({ 0, 0 });
+    }
+    slots_[slot].dense = dense;
+    denseToSlot_.push_back(slot);
+
+    posX_.push_back(position.x);
+    posY_.push_back(position.y);
+    velX_.push_back(0.0f);
+    velY_.push_back(0.0f);
+    animTime_.push_back(0.0f);
+    patrolTimer_.push_back(0.0f);
+    patrolDir_.push_back(0.0f);
+    rng_.push_back(rng);
+    steerX_.push_back(0.0f);
+    steerY_.push_back(0.0f);
+    chasing_.push_back(0);
+    activity_.push_back(static_cast<std::uint8_t>(EnemyActivity::Active));
+    stepDt_.push_back(0.0f);
+    pendingDt_.push_back(0.0f);
+    wakeTimer_.push_back(0.0f);
+
+    halfW_.push_back(width * 0.5f);
+    halfH_.push_back(height * 0.5f);
+    radius_.push_back(0.5f * glm::length(glm::vec2(width, height)) * collisionScale);
+
+    type_.push_back(static_cast<std::uint8_t>(typeId));
+    sheet_.push_back(sheet);
+    clip_.push_back(clip);
+    return { slot, slots_[slot].generation };
+}
+
+void EnemyStore::RemoveAt(std::size_t index) {
+    std::size_t last = Size() - 1;
+
+    // Retire the slot; bumping the generation invalidates old handles
+    std::uint32_t slot = denseToSlot_[index];
+    ++slots_[slot].generation;
+    freeSlots_.push_back(slot);
+
+    // Swap-and-pop every array
+    ForEachArray(*this, [index, last](auto& v) {
+        if (index != last) v[index] = std::move(v[last]);
+        v.pop_back();
+    });
+
+    if (index != last)
+        slots_[denseToSlot_[index]].dense = static_cast<std::uint32_t>(index);
+}
+
+void EnemyStore::Remove(EnemyHandle handle) {
+    std::size_t index = IndexOf(handle);
+    if (index != NotFound)
+        RemoveAt(index);
+}
+
+std::size_t EnemyStore::GetMemoryUsage() const {
+    std::size_t bytes = 0;
+    ForEachArray(*this, [&bytes](const auto& v) { bytes += v.capacity() * sizeof(v[0]); });
+    return bytes + slots_.capacity() * sizeof(Slot) + freeSlots_.capacity() * sizeof(std::uint32_t);
+}
+
+std::size_t EnemyStore::EstimateMemoryUsage(std::size_t capacity) {
+    std::size_t perEnemy = sizeof(Slot) + sizeof(std::uint32_t);
+    EnemyStore layout;
+    ForEachArray(layout, [&perEnemy](const auto& v) { perEnemy += sizeof(v[0]); });
+    return capacity * perEnemy;
+}
+
+bool EnemyStore::IsAlive(EnemyHandle handle) const {
+    return IndexOf(handle) != NotFound;
+}
+
+std::size_t EnemyStore::IndexOf(EnemyHandle handle) const {
+    if (handle.slot >= slots_.size()) return NotFound;
+    const Slot& slot = slots_[handle.slot];
+    if (slot.generation != handle.generation || slot.dense >= Size()) return NotFound;
+    // A freed slot keeps its stale dense index; make sure it still maps back
+    return denseToSlot_[slot.dense] == handle.slot ? slot.dense : NotFound;
+}
+
+void EnemyStore::Clear() {
+    ForEachArray(*this, [](auto& v) { v.clear(); });
+    sheets_.clear();
+
+    // Every live slot dies; keep generations so old handles stay invalid
+    freeSlots_.clear();
+    for (std::uint32_t slot = 0; slot < slots_.size(); ++slot) {
+        ++slots_[slot].generation;
+        freeSlots_.push_back(slot);
+    }
+}
+
+void EnemyStore::Update(float dt,
+                        const std::vector<const std::vector<std::vector<int>>*>& mapDataPtrs,
+                        const std::unordered_set<int>& solidTiles,
+                        int tileWidth, int tileHeight,
+                        const Circle& playerCircle,
+                        const EnemyNavigation& navigation,
+                        const ViewRect* visible) {
+    UpdateActivity(dt, playerCircle.center, visible);
+
+    // Path queries share the pathfinder's cache, so they run here, serially
+    if (navigation.pathfinder)
+        UpdateChaseTargets(playerCircle, navigation);
+
+    UpdateContext ctx{ mapDataPtrs, solidTiles, tileWidth, tileHeight, playerCircle,
+        glm::vec2(mapDataPtrs[0]->at(0).size() * tileWidth, mapDataPtrs[0]->size() * tileHeight),
+        navigation.flowField };
+
+    // Each enemy only reads the (read-only) map and writes its own slots,
+    // so chunks can run in any order and the result is the same as serial
+    JobSystem::ParallelFor(Size(), UpdateChunkSize, [this, &ctx](std::size_t begin, std::size_t end) {
+        UpdateRange(begin, end, ctx);
+    });
+}
+
+void EnemyStore::UpdateActivity(float dt, glm::vec2 focus, const ViewRect* visible) {
+    ++tick_;
+    const EnemyActivityConfig& cfg = activityConfig_;
+    const bool enabled = cfg.activeRadius > 0.0f;
+    const float activeSq = cfg.activeRadius * cfg.activeRadius;
+    const float sleepSq = std::max(cfg.sleepRadius, cfg.activeRadius) * std::max(cfg.sleepRadius, cfg.activeRadius);
+    const auto interval = static_cast<std::uint32_t>(std::max(cfg.reducedInterval, 1));
+    ViewRect view;
+    if (visible) {
+        view.min = visible->min - glm::vec2(cfg.viewMargin);
+        view.max = visible->max + glm::vec2(cfg.viewMargin);
+    }
+
+    awakeCount_ = 0;
+    for (std::size_t i = 0; i < Size(); ++i) {
+        Circle bounds = ComputeBoundingCircle(i);
+        glm::vec2 d = bounds.center - focus;
+        float distSq = glm::dot(d, d);
+        wakeTimer_[i] = std::max(wakeTimer_[i] - dt, 0.0f);
+        bool onScreen = visible && view.Overlaps(bounds.center - glm::vec2(bounds.radius),
+                                                 bounds.center + glm::vec2(bounds.radius));
+
+        EnemyActivity activity = EnemyActivity::Active;
+        if (enabled && !onScreen && wakeTimer_[i] <= 0.0f && distSq > activeSq)
+            activity = distSq > sleepSq ? EnemyActivity::Sleeping : EnemyActivity::Reduced;
+        activity_[i] = static_cast<std::uint8_t>(activity);
+
+        switch (activity) {
+        case EnemyActivity::Active:
+            // Catch up on anything saved while reduced
+            stepDt_[i] = dt + pendingDt_[i];
+            pendingDt_[i] = 0.0f;
+            ++awakeCount_;
+            break;
+        case EnemyActivity::Reduced:
+            // Staggered by slot so the reduced ticks spread over the interval
+            pendingDt_[i] += dt;
+            if ((tick_ + denseToSlot_[i]) % interval == 0) {
+                stepDt_[i] = pendingDt_[i];
+                pendingDt_[i] = 0.0f;
+            } else {
+                stepDt_[i] = 0.0f;
+            }
+            break;
+        case EnemyActivity::Sleeping:
+            // Time stops: a sleeper wakes exactly as it fell asleep
+            stepDt_[i] = 0.0f;
+            pendingDt_[i] = 0.0f;
+            break;
+        }
+    }
+}
+
+void EnemyStore::WakeNear(glm::vec2 center, float radius) {
+    for (std::size_t i = 0; i < Size(); ++i) {
+        glm::vec2 d = ComputeBoundingCircle(i).center - center;
+        if (glm::dot(d, d) <= radius * radius)
+            wakeTimer_[i] = activityConfig_.wakeDuration;
+    }
+}
+
+void EnemyStore::UpdateChaseTargets(const Circle& playerCircle, const EnemyNavigation& navigation) {
+    Pathfinder& pathfinder = *navigation.pathfinder;
+    HierarchicalPathfinder* hierarchical = navigation.hierarchical;
+    const NavGrid* grid = pathfinder.GetGrid();
+    if (!grid || grid->Empty()) return;
+
+    const std::vector<EnemyTypeParams>& types = EnemyRegistry::Table();
+    glm::ivec2 goal = grid->CellAt(playerCircle.center);
+
+    for (std::size_t i = 0; i < Size(); ++i) {
+        const EnemyTypeParams& t = types[type_[i]];
+        if (t.behavior != EnemyBehavior::Chase || stepDt_[i] <= 0.0f) continue;
+        chasing_[i] = 0;
+
+        glm::vec2 center = ComputeBoundingCircle(i).center;
+        glm::vec2 toPlayer = playerCircle.center - center;
+        if (glm::dot(toPlayer, toPlayer) > t.chaseRadius * t.chaseRadius) continue;
+
+        // Head for the next cell centre; in the dog's cell, head for the dog.
+        // Far targets go through the cluster graph instead of a full A*.
+        glm::ivec2 start = grid->CellAt(center);
+        int cells = std::max(std::abs(goal.x - start.x), std::abs(goal.y - start.y));
+        glm::vec2 target;
+        if (hierarchical && cells > hierarchical->GetClusterSize()) {
+            glm::ivec2 next;
+            if (!hierarchical->NextStep(start, goal, next)) continue;
+            target = grid->CellCenter(next);
+        } else {
+            const Pathfinder::Path& path = pathfinder.FindPath(start, goal);
+            if (!path.found) continue;
+            target = path.cells.empty() ? playerCircle.center : grid->CellCenter(path.cells.front());
+        }
+        glm::vec2 dir = target - center;
+        float len = glm::length(dir);
+        if (len < 0.001f) continue;
+
+        steerX_[i] = dir.x / len;
+        steerY_[i] = dir.y / len;
+        chasing_[i] = 1;
+    }
+}
+
+void EnemyStore::UpdateRange(std::size_t begin, std::size_t end, const UpdateContext& ctx) {
+    const std::vector<EnemyTypeParams>& types = EnemyRegistry::Table();
+
+    // 🔁 Animate (active enemies only; reduced ones hold their frame)
+    for (std::size_t i = begin; i < end; ++i) {
+        if (activity_[i] != static_cast<std::uint8_t>(EnemyActivity::Active)) continue;
+        const SpriteSheet& anim = AnimationLibrary::Sheet(sheets_[sheet_[i]].animation);
+        animTime_[i] = anim.Advance(clip_[i], animTime_[i], stepDt_[i]);
+    }
+
+    // 🐝 Swarm AI: follow the shared flow field downhill to the dog. Without
+    // a valid field (dog off the grid or on a blocked cell) they patrol.
+    const bool haveField = ctx.flowField && ctx.flowField->IsValid();
+    for (std::size_t i = begin; i < end; ++i) {
+        const EnemyTypeParams& t = types[type_[i]];
+        if (t.behavior != EnemyBehavior::Swarm || stepDt_[i] <= 0.0f) continue;
+        chasing_[i] = 0;
+        if (!haveField) continue;
+
+        glm::vec2 center = ComputeBoundingCircle(i).center;
+        glm::vec2 toPlayer = ctx.playerCircle.center - center;
+        if (t.chaseRadius > 0.0f && glm::dot(toPlayer, toPlayer) > t.chaseRadius * t.chaseRadius) continue;
+
+        glm::ivec2 cell(static_cast<int>(center.x) / ctx.tileWidth, static_cast<int>(center.y) / ctx.tileHeight);
+        glm::vec2 dir;
+        if (cell == ctx.flowField->GetGoal()) {
+            // Same tile as the dog: go straight for it
+            float len = glm::length(toPlayer);
+            if (len < 0.001f) continue;
+            dir = toPlayer / len;
+        } else {
+            dir = ctx.flowField->DirectionAt(cell);
+            if (dir == glm::vec2(0.0f)) continue;
+        }
+        steerX_[i] = dir.x;
+        steerY_[i] = dir.y;
+        chasing_[i] = 1;
+    }
+
+    // 🤖 Patrol AI: new direction every interval, or right after being blocked.
+    // Chasers patrol too while the dog is out of range.
+    for (std::size_t i = begin; i < end; ++i) {
+        if (types[type_[i]].behavior == EnemyBehavior::Idle || chasing_[i] || stepDt_[i] <= 0.0f) continue;
+        patrolTimer_[i] += stepDt_[i];
+        if (patrolTimer_[i] >= types[type_[i]].patrolInterval || patrolDir_[i] == 0.0f) {
+            patrolTimer_[i] = 0.0f;
+            patrolDir_[i] = static_cast<float>(rng_[i].NextInt(-1, 1));
+        }
+    }
+
+    for (std::size_t i = begin; i < end; ++i) {
+        const EnemyTypeParams& t = types[type_[i]];
+        if (chasing_[i]) {
+            velX_[i] = steerX_[i] * t.chaseSpeed;
+            velY_[i] = steerY_[i] * t.chaseSpeed;
+        } else {
+            velX_[i] = patrolDir_[i] * t.patrolSpeed;
+            velY_[i] = 0.0f;
+        }
+    }
+
+    // 🚶 Move against the tile map
+    for (std::size_t i = begin; i < end; ++i) {
+        const float dt = stepDt_[i];
+        if (dt <= 0.0f) continue;
+        Circle c = ComputeBoundingCircle(i);
+        auto tryMove = [&](glm::vec2 v) {
+            return TryMoveCircle(c, v, dt, ctx.mapSize, ctx.mapDataPtrs, ctx.solidTiles, ctx.tileWidth, ctx.tileHeight);
+        };
+        bool moved = tryMove({ velX_[i], velY_[i] });
+        // Chasers slide along walls instead of stopping at corners
+        if (!moved && chasing_[i])
+            moved = tryMove({ velX_[i], 0.0f }) || tryMove({ 0.0f, velY_[i] });
+
+        if (!moved) {
+            velX_[i] = velY_[i] = 0.0f;
+            patrolDir_[i] = 0.0f;
+        } else {
+            posX_[i] = c.center.x - halfW_[i];
+            posY_[i] = c.center.y - halfH_[i];
+        }
+    }
+}
+
+void EnemyStore::Submit(RenderQueue& queue, std::uint8_t layer, const ViewRect* visible) const {
+    // Ranges of enemies are built on the job system, like the update
+    queue.SubmitParallel(Size(), SubmitChunkSize, [&](std::size_t begin, std::size_t end, RenderQueue& out) {
+        std::size_t cachedSheet = sheets_.size();
+        const SpriteSheet* anim = nullptr;
+        SpriteCommand cmd;
+        for (std::size_t i = begin; i < end; ++i) {
+            glm::vec2 pos(posX_[i], posY_[i]);
+            glm::vec2 size = glm::vec2(halfW_[i], halfH_[i]) * 2.0f;
+            if (visible && !visible->Overlaps(pos, pos + size)) continue;
+
+            const EnemySheet& s = sheets_[sheet_[i]];
+            if (sheet_[i] != cachedSheet) {
+                cachedSheet = sheet_[i];
+                anim = &AnimationLibrary::Sheet(s.animation);
+                cmd.shader = s.shader.get();
+                cmd.texture = s.texture.get();
+            }
+
+            cmd.position = pos;
+            cmd.size = size;
+            cmd.uvRect = RemapUV(s.region, anim->Sample(clip_[i], animTime_[i]));
+            auto depth = static_cast<std::uint32_t>(std::max(0.0f, pos.y + size.y));
+            out.Submit(RenderQueue::MakeKey(layer, cmd, depth), cmd);
+        }
+    });
+}
+
@@ -0,0 +1,206 @@
+// EnemyStore.h
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AnimationClip.h"
+#include "Camera.h"
+#include "Collision.h"
+#include "FlowField.h"
+#include "HierarchicalPathfinder.h"
+#include "Pathfinder.h"
+#include "Random.h"
+#include "RenderQueue.h"
+#include "shader.h"
+#include "texture.h"
+
+// Texture and clip table an enemy draws from. Shared by every enemy spawned
+// with the same shader, texture and AnimationLibrary sheet.
+struct EnemySheet {
+	std::shared_ptr<Shader> shader;
+	std::shared_ptr<Texture2D> texture;
+	int animation = 0;   // AnimationLibrary sheet id
+	glm::vec4 region{ 0.0f, 0.0f, 1.0f, 1.0f };   // where the sheet sits in texture (atlas page)
+};
+
+// Stable reference to an enemy. The generation changes every time a slot
+// is reused, so a handle to a killed enemy never aliases a newer one.
+struct EnemyHandle {
+	std::uint32_t slot = ~0u;
+	std::uint32_t generation = 0;
+
+	bool operator==(const EnemyHandle&) const = default;
+};
+
+// Level navigation data the enemy AI may use during an update
+struct EnemyNavigation {
+	Pathfinder* pathfinder = nullptr;      // Chase: queried serially before the jobs
+	HierarchicalPathfinder* hierarchical = nullptr;  // Chase, beyond one cluster away
+	const FlowField* flowField = nullptr;  // Swarm: read-only from every job
+};
+
+// Simulation level of detail around the dog. Enemies within activeRadius
+// run the full update; out to sleepRadius they tick every reducedInterval
+// updates with the time saved up and no animation (coarse movement);
+// beyond that they sleep. Enemies overlapping the camera's view, grown by
+// viewMargin, are always active, so nothing on screen ever slows down
+// (the view isn't centred on the dog at map edges). WakeNear() keeps
+// enemies fully active for wakeDuration seconds wherever they are; the
+// level calls it with wakeRadius around every bite. activeRadius <= 0
+// turns the system off and every enemy runs the full update.
+struct EnemyActivityConfig {
+	float activeRadius = 320.0f;
+	float sleepRadius = 640.0f;
+	int reducedInterval = 4;
+	float wakeDuration = 3.0f;
+	float wakeRadius = 160.0f;   // how far a bite is heard
+	float viewMargin = 64.0f;
+};
+
+enum class EnemyActivity : std::uint8_t { Active, Reduced, Sleeping };
+
+// All enemies of a level, stored as parallel arrays (structure of arrays).
+// Index i in every array is the same enemy. Behaviour comes from the
+// per-type tables in EnemyRegistry, so the update is a handful of flat loops
+// instead of one virtual call per enemy.
+class EnemyStore {
+public:
+	EnemyStore() = default;
+
+	// Returns the sheet index for this shader/texture/animation, adding it if needed
+	std::uint16_t AddSheet(std::shared_ptr<Shader> shader, std::shared_ptr<Texture2D> texture, int animation,
+						   glm::vec4 region = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+
+	// Grows every array (and the slot table) up front so spawning up to
+	// capacity enemies never allocates
+	void Reserve(std::size_t capacity);
+
+	// clip is a clip id of the sheet's SpriteSheet
+	EnemyHandle Spawn(int typeId, std::uint16_t sheet, glm::vec2 position, std::uint16_t clip,
+					  float scale, float collisionScale, const Rng& rng);
+	// O(1): the last enemy is moved into the hole, so indices are not stable
+	// across removals. Hold an EnemyHandle to refer to an enemy over time.
+	void RemoveAt(std::size_t index);
+	void Remove(EnemyHandle handle);
+	void Clear();
+
+	bool IsAlive(EnemyHandle handle) const;
+	// Dense index of a live enemy, or NotFound
+	std::size_t IndexOf(EnemyHandle handle) const;
+	EnemyHandle HandleAt(std::size_t index) const {
+		return { denseToSlot_[index], slots_[denseToSlot_[index]].generation };
+	}
+	static constexpr std::size_t NotFound = static_cast<std::size_t>(-1);
+
+	std::size_t Size() const { return posX_.size(); }
+	bool Empty() const { return posX_.empty(); }
+
+	void Update(float dt,
+				const std::vector<const std::vector<std::vector<int>>*>& mapDataPtrs,
+				const std::unordered_set<int>& solidTiles,
+				int tileWidth, int tileHeight,
+				const Circle& playerCircle,
+				const EnemyNavigation& navigation = {},
+				const ViewRect* visible = nullptr);
+	// Queues the enemies overlapping visible (all when null) on layer,
+	// back to front by their bottom edge
+	void Submit(RenderQueue& queue, std::uint8_t layer, const ViewRect* visible = nullptr) const;
+
+	void SetActivityConfig(const EnemyActivityConfig& config) { activityConfig_ = config; }
+	const EnemyActivityConfig& GetActivityConfig() const { return activityConfig_; }
+	// Event hook (noise, bites, ...): wakes every enemy whose centre is within radius
+	void WakeNear(glm::vec2 center, float radius);
+	EnemyActivity GetActivity(std::size_t i) const { return static_cast<EnemyActivity>(activity_[i]); }
+	std::size_t GetAwakeCount() const { return awakeCount_; }
+
+	// Bytes reserved by the per-enemy arrays and the slot table
+	std::size_t GetMemoryUsage() const;
+	// What GetMemoryUsage reports after Reserve(capacity) on an empty store
+	static std::size_t EstimateMemoryUsage(std::size_t capacity);
+
+	glm::vec2 GetPosition(std::size_t i) const { return { posX_[i], posY_[i] }; }
+	Circle ComputeBoundingCircle(std::size_t i) const {
+		return { { posX_[i] + halfW_[i], posY_[i] + halfH_[i] }, radius_[i] };
+	}
+
+private:
+	// Hot simulation state
+	std::vector<float> posX_, posY_;
+	std::vector<float> velX_, velY_;
+	std::vector<float> animTime_;
+	std::vector<float> patrolTimer_;
+	std::vector<float> patrolDir_;    // -1, 0 or 1 along x
+	std::vector<Rng> rng_;
+
+	// Chase steering, written by the serial path pass before each update
+	std::vector<float> steerX_, steerY_;
+	std::vector<std::uint8_t> chasing_;
+
+	// Level of detail, classified serially at the start of each update.
+	// stepDt_ is the time this enemy simulates this update (0 = skip).
+	std::vector<std::uint8_t> activity_;
+	std::vector<float> stepDt_;
+	std::vector<float> pendingDt_;    // time saved up between reduced ticks
+	std::vector<float> wakeTimer_;
+
+	// Set at spawn; the collision circle never changes size
+	std::vector<float> halfW_, halfH_, radius_;
+
+	// Animation / rendering
+	std::vector<std::uint8_t> type_;
+	std::vector<std::uint16_t> sheet_;
+	std::vector<std::uint16_t> clip_;
+
+	std::vector<EnemySheet> sheets_;
+
+	// Slot map: handle.slot -> dense index (while alive), plus the reverse
+	// mapping for the swap on removal. Freed slots are reused LIFO.
+	struct Slot {
+		std::uint32_t dense;
+		std::uint32_t generation;
+	};
+	std::vector<Slot> slots_;
+	std::vector<std::uint32_t> denseToSlot_;
+	std::vector<std::uint32_t> freeSlots_;
+
+	EnemyActivityConfig activityConfig_;
+	std::uint32_t tick_ = 0;
+	std::size_t awakeCount_ = 0;
+
+	// Enemies per job; small enough to spread a few hundred over the pool
+	static constexpr std::size_t UpdateChunkSize = 64;
+	// Submitting is a few loads and stores per enemy; bigger jobs
+	static constexpr std::size_t SubmitChunkSize = 1024;
+
+	struct UpdateContext {
+		const std::vector<const std::vector<std::vector<int>>*>& mapDataPtrs;
+		const std::unordered_set<int>& solidTiles;
+		int tileWidth, tileHeight;
+		const Circle& playerCircle;
+		glm::vec2 mapSize;
+		const FlowField* flowField;
+	};
+	void UpdateActivity(float dt, glm::vec2 focus, const ViewRect* visible);
+	void UpdateRange(std::size_t begin, std::size_t end, const UpdateContext& ctx);
+	void UpdateChaseTargets(const Circle& playerCircle, const EnemyNavigation& navigation);
+
+	// Applies f to every per-enemy array (everything indexed by dense index)
+	template <typename Self, typename F>
+	static void ForEachArray(Self& self, F&& f) {
+		f(self.posX_); f(self.posY_);
+		f(self.velX_); f(self.velY_);
+		f(self.animTime_);
+		f(self.patrolTimer_); f(self.patrolDir_);
+		f(self.rng_);
+		f(self.steerX_); f(self.steerY_); f(self.chasing_);
+		f(self.activity_); f(self.stepDt_); f(self.pendingDt_); f(self.wakeTimer_);
+		f(self.halfW_); f(self.halfH_); f(self.radius_);
+		f(self.type_); f(self.sheet_); f(self.clip_);
+		f(self.denseToSlot_);
+	}
+};
@@ -0,0 +1,95 @@
+// FlowField.cpp
+#include "FlowField.h"
+
+#include <algorithm>
+
+namespace {
+    // Orthogonal first so ties prefer straight moves
+    constexpr int neighbourX[] = { 1, -1, 0,  0, 1, -1,  1, -1 };
+    constexpr int neighbourY[] = { 0,  0, 1, -1, 1,  1, -1, -1 };
+    constexpr int NeighbourCount = 8;
+
+    const glm::vec2 neighbourDir[] = {
+        { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f },
+        glm::normalize(glm::vec2( 1.0f,  1.0f)), glm::normalize(glm::vec2(-1.0f,  1.0f)),
+        glm::normalize(glm::vec2( 1.0f, -1.0f)), glm::normalize(glm::vec2(-1.0f, -1.0f)),
+    };
+
+    // Diagonal steps may not clip the corner of a blocked tile
+    bool CanStep(const NavGrid& grid, int x, int y, int n) {
+        int nx = x + neighbourX[n], ny = y + neighbourY[n];
+        if (grid.IsBlocked(nx, ny)) return false;
+        if (n >= 4 && (grid.IsBlocked(nx, y) || grid.IsBlocked(x, ny))) return false;
+        return true;
+    }
+}
+
+void FlowField::SetGrid(const NavGrid* grid) {
+    grid_ = grid;
+    std::size_t cells = grid ? static_cast<std::size_t>(grid->GetCellCount()) : 0;
+    distance_.assign(cells, Unreachable);
+    direction_.assign(cells, -1);
+    queue_.resize(cells);
+    hasGoal_ = false;
+}
+
+bool FlowField::Update(glm::ivec2 goal, bool force) {
+    if (!grid_ || grid_->Empty()) return false;
+    if (!force && hasGoal_ && goal == goal_) return false;
+
+    goal_ = goal;
+    hasGoal_ = true;
+    Build();
+    return true;
+}
+
+glm::vec2 FlowField::DirectionAt(glm::ivec2 cell) const {
+    if (!grid_ || !grid_->InBounds(cell.x, cell.y)) return glm::vec2(0.0f);
+    int n = direction_[grid_->Index(cell.x, cell.y)];
+    return n < 0 ? glm::vec2(0.0f) : neighbourDir[n];
+}
+
+void FlowField::Build() {
+    ++builds_;
+    std::fill(distance_.begin(), distance_.end(), Unreachable);
+    std::fill(direction_.begin(), direction_.end(), std::int8_t(-1));
+
+    // Dog off the map or inside a wall: nothing to flow towards
+    if (grid_->IsBlocked(goal_.x, goal_.y)) return;
+
+    // 1) Breadth-first integration: steps to the goal (diagonals count 1)
+    std::size_t head = 0, tail = 0;
+    int goalIndex = grid_->Index(goal_.x, goal_.y);
+    distance_[goalIndex] = 0;
+    queue_[tail++] = goalIndex;
+
+    while (head < tail) {
+        int index = queue_[head++];
+        glm::ivec2 cell = grid_->CellOf(index);
+        std::uint16_t next = static_cast<std::uint16_t>(distance_[index] + 1);
+        if (next == Unreachable) continue;
+
+        for (int n = 0; n < NeighbourCount; ++n) {
+            if (!CanStep(*grid_, cell.x, cell.y, n)) continue;
+            int ni = grid_->Index(cell.x + neighbourX[n], cell.y + neighbourY[n]);
+            if (distance_[ni] != Unreachable) continue;
+            distance_[ni] = next;
+            queue_[tail++] = ni;
+        }
+    }
+
+    // 2) Each reached cell points at its lowest neighbour
+    for (std::size_t q = 1; q < tail; ++q) {
+        int index = queue_[q];
+        glm::ivec2 cell = grid_->CellOf(index);
+        std::uint16_t best = distance_[index];
+        for (int n = 0; n < NeighbourCount; ++n) {
+            if (!CanStep(*grid_, cell.x, cell.y, n)) continue;
+            std::uint16_t d = distance_[grid_->Index(cell.x + neighbourX[n], cell.y + neighbourY[n])];
+            if (d < best) {
+                best = d;
+                direction_[index] = static_cast<std::int8_t>(n);
+            }
+        }
+    }
+}
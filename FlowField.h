@@ -0,0 +1,45 @@
+// FlowField.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "NavGrid.h"
+
+// Distance field from one goal cell (the dog) over a NavGrid, plus the
+// downhill direction in every cell. Built once when the goal changes
+// tile, after which any number of chasers read their heading in O(1).
+class FlowField {
+public:
+	static constexpr std::uint16_t Unreachable = 0xFFFF;
+
+	void SetGrid(const NavGrid* grid);
+
+	// Rebuilds when the goal cell changed (or force); returns true if it did
+	bool Update(glm::ivec2 goal, bool force = false);
+
+	bool IsValid() const { return hasGoal_; }
+	glm::ivec2 GetGoal() const { return goal_; }
+	std::uint16_t DistanceAt(glm::ivec2 cell) const {
+		return grid_ && grid_->InBounds(cell.x, cell.y) ? distance_[grid_->Index(cell.x, cell.y)] : Unreachable;
+	}
+	// Unit vector towards the next cell on a shortest path; zero in the goal
+	// cell and wherever the goal can't be reached
+	glm::vec2 DirectionAt(glm::ivec2 cell) const;
+
+	std::uint64_t GetBuildCount() const { return builds_; }
+
+private:
+	void Build();
+
+	const NavGrid* grid_ = nullptr;
+	glm::ivec2 goal_{ 0 };
+	bool hasGoal_ = false;
+
+	std::vector<std::uint16_t> distance_;
+	std::vector<std::int8_t> direction_;   // index into the neighbour table, -1 = none
+	std::vector<int> queue_;               // BFS frontier, sized once per grid
+	std::uint64_t builds_ = 0;
+};
@@ -0,0 +1,164 @@
+// FramePacer.cpp
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include <GLFW/glfw3.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+#include "Log.h"
+
+namespace {
+    using Milliseconds = std::chrono::duration<float, std::milli>;
+
+    FramePacer::Clock::duration ToDuration(float ms) {
+        return std::chrono::duration_cast<FramePacer::Clock::duration>(Milliseconds(ms));
+    }
+
+    const char* Name(VsyncMode mode) {
+        switch (mode) {
+        case VsyncMode::Off: return "off";
+        case VsyncMode::On: return "on";
+        case VsyncMode::Adaptive: return "adaptive";
+        }
+        return "?";
+    }
+}
+
+void FramePacer::Init(GLFWwindow* window) {
+    window_ = window;
+
+    int interval = 1;
+    if (config_.vsync == VsyncMode::Off) {
+        interval = 0;
+    } else if (config_.vsync == VsyncMode::Adaptive) {
+        if (glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+            interval = -1;
+        } else {
+            LOG_WARN("🎞️ Adaptive vsync not supported, using vsync on");
+            config_.vsync = VsyncMode::On;
+        }
+    }
+    glfwSwapInterval(interval);
+
+    limiting_ = config_.targetFps > 0.0f;
+    if (limiting_) {
+        periodMs_ = 1000.0f / config_.targetFps;
+    } else if (interval != 0) {
+        // Vsync alone: the display's refresh is the deadline
+        const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+        int refresh = mode && mode->refreshRate > 0 ? mode->refreshRate : 60;
+        periodMs_ = 1000.0f / static_cast<float>(refresh);
+    } else {
+        periodMs_ = 0.0f;
+    }
+
+    if (config_.justInTime && periodMs_ <= 0.0f) {
+        LOG_WARN("🎞️ Just-in-time pacing needs a target fps or vsync; turned off");
+        config_.justInTime = false;
+    }
+
+#ifdef _WIN32
+    // Millisecond sleeps instead of the default ~15.6 ms scheduler tick
+    timeBeginPeriod(1);
+#endif
+
+    LOG_INFO("🎞️ Frame pacing: vsync %s, %s%s", Name(config_.vsync),
+             limiting_ ? "limited" : "unlimited", config_.justInTime ? ", just-in-time" : "");
+    if (periodMs_ > 0.0f)
+        LOG_INFO("🎞️ Frame period %.2f ms", periodMs_);
+}
+
+void FramePacer::Shutdown() {
+    if (!window_) return;
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+    window_ = nullptr;
+}
+
+void FramePacer::BeginFrame() {
+    if (config_.justInTime && hasPresented_) {
+        // Start as late as the slowest recent frame still makes the deadline
+        float slowest = *std::max_element(workMs_.begin(), workMs_.end());
+        Clock::time_point start = deadline_ - ToDuration(slowest + config_.marginMs);
+        if (start > Clock::now())
+            WaitUntil(start, config_.spinMs);
+    }
+    workStart_ = Clock::now();
+}
+
+void FramePacer::Present() {
+    Clock::time_point now = Clock::now();
+    workMs_[workHead_] = Milliseconds(now - workStart_).count();
+    workHead_ = (workHead_ + 1) % WorkHistorySize;
+
+    if (limiting_) {
+        if (!hasPresented_)
+            deadline_ = now;
+        WaitUntil(deadline_, config_.spinMs);
+    }
+
+    glfwSwapBuffers(window_);
+    Clock::time_point presented = Clock::now();
+
+    if (hasPresented_) {
+        float ms = Milliseconds(presented - lastPresent_).count();
+        ++frames_;
+        double delta = ms - mean_;
+        mean_ += delta / static_cast<double>(frames_);
+        m2_ += delta * (ms - mean_);
+        minMs_ = frames_ == 1 ? ms : std::min(minMs_, ms);
+        maxMs_ = std::max(maxMs_, ms);
+        if (periodMs_ > 0.0f && ms > periodMs_ * 1.5f)
+            ++late_;
+    }
+    lastPresent_ = presented;
+    hasPresented_ = true;
+
+    if (limiting_) {
+        deadline_ += ToDuration(periodMs_);
+        // Too far behind to catch up: restart the cadence from now
+        if (deadline_ < presented)
+            deadline_ = presented + ToDuration(periodMs_);
+    } else {
+        // Vsync: the swap came back at a refresh, the next is a period on
+        deadline_ = presented + ToDuration(periodMs_);
+    }
+}
+
+FramePacer::Report FramePacer::GetReport() const {
+    Report report;
+    report.frames = frames_;
+    report.meanMs = static_cast<float>(mean_);
+    report.stdDevMs = frames_ > 0 ? static_cast<float>(std::sqrt(m2_ / static_cast<double>(frames_))) : 0.0f;
+    report.minMs = minMs_;
+    report.maxMs = maxMs_;
+    report.late = late_;
+    return report;
+}
+
+void FramePacer::LogReport() const {
+    if (frames_ == 0) return;
+    Report r = GetReport();
+    LOG_INFO("🎞️ %llu frames: %.2f ms avg, stddev %.3f ms, min %.2f, max %.2f, %llu late",
+             static_cast<unsigned long long>(r.frames), r.meanMs, r.stdDevMs, r.minMs, r.maxMs,
+             static_cast<unsigned long long>(r.late));
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline, float spinMs) {
+    Clock::duration spin = ToDuration(spinMs);
+    Clock::time_point now = Clock::now();
+    if (deadline - now > spin)
+        std::this_thread::sleep_for(deadline - now - spin);
+    // The scheduler overshoots sleeps by up to a tick; spin the rest
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+}
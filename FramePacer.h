@@ -0,0 +1,89 @@
+// FramePacer.h
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct GLFWwindow;
+
+// Adaptive = late frames tear instead of waiting a whole refresh; needs
+// the *_swap_control_tear extension and falls back to On without it
+enum class VsyncMode { Off, On, Adaptive };
+
+struct FramePacingConfig {
+	VsyncMode vsync = VsyncMode::On;
+	// Frame rate limiter; 0 = unlimited (vsync, if on, still paces)
+	float targetFps = 0.0f;
+	// Just-in-time: the wait moves to the start of the frame, so input is
+	// sampled as late as the predicted frame work allows. Needs a limiter
+	// or vsync to know when the frame is due.
+	bool justInTime = false;
+	// Waits sleep until this close to the deadline, then spin
+	float spinMs = 1.5f;
+	// Just-in-time headroom on top of the slowest recent frame
+	float marginMs = 2.0f;
+};
+
+// Paces the main loop: swap interval, a sleep-plus-spin limiter to the
+// target rate and the optional just-in-time start. Present replaces
+// glfwSwapBuffers. Present-to-present intervals are kept for the report.
+class FramePacer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Report {
+		std::uint64_t frames = 0;
+		float meanMs = 0.0f, stdDevMs = 0.0f;
+		float minMs = 0.0f, maxMs = 0.0f;
+		std::uint64_t late = 0;   // intervals over 1.5 frame periods
+	};
+
+	explicit FramePacer(const FramePacingConfig& config = {}) : config_(config) { }
+	~FramePacer() { Shutdown(); }
+	FramePacer(const FramePacer&) = delete;
+	FramePacer& operator=(const FramePacer&) = delete;
+
+	// Applies the swap interval; the window's context must be current
+	void Init(GLFWwindow* window);
+	void Shutdown();
+
+	// Start of a frame, before input: the just-in-time wait
+	void BeginFrame();
+	// End of a frame: waits for the limiter deadline, swaps, and records
+	// the interval since the last present
+	void Present();
+
+	// Time one frame is given; 0 when nothing paces the loop
+	float GetPeriodMs() const { return periodMs_; }
+	const FramePacingConfig& GetConfig() const { return config_; }
+	Report GetReport() const;
+	void LogReport() const;
+
+	// Sleeps until spin before deadline, then spins up to it
+	static void WaitUntil(Clock::time_point deadline, float spinMs);
+
+private:
+	FramePacingConfig config_;
+	GLFWwindow* window_ = nullptr;
+	float periodMs_ = 0.0f;
+	bool limiting_ = false;
+
+	Clock::time_point deadline_{};     // when the next present is due
+	Clock::time_point workStart_{};
+	Clock::time_point lastPresent_{};
+	bool hasPresented_ = false;
+
+	// Work (BeginFrame to Present) of the last frames; just-in-time plans
+	// for the slowest
+	static constexpr std::size_t WorkHistorySize = 32;
+	std::array<float, WorkHistorySize> workMs_{};
+	std::size_t workHead_ = 0;
+
+	// Running present-interval statistics (Welford)
+	std::uint64_t frames_ = 0;
+	double mean_ = 0.0, m2_ = 0.0;
+	float minMs_ = 0.0f, maxMs_ = 0.0f;
+	std::uint64_t late_ = 0;
+};
@@ -0,0 +1,118 @@
+// FramePipeline.cpp
+#include "FramePipeline.h"
+
+#include "DebugDraw.h"
+#include "FrameUniforms.h"
+#include "Level.h"
+#include "Log.h"
+
+void RenderSnapshot::Reset(std::uint64_t revision) {
+    revision_ = revision;
+    for (std::size_t i = 0; i < viewCount_; ++i)
+        views_[i].queue.Clear();
+    viewCount_ = 0;
+    debugLevel_ = nullptr;
+    debugShader_.reset();
+    debugCircles_.clear();
+}
+
+RenderQueue& RenderSnapshot::AddView(const glm::mat4& viewProjection) {
+    if (viewCount_ == views_.size())
+        views_.emplace_back();
+    View& view = views_[viewCount_++];
+    view.viewProjection = viewProjection;
+    view.queue.Clear();
+    return view.queue;
+}
+
+void RenderSnapshot::AddDebugCircle(const Circle& circle, const glm::vec3& color) {
+    debugCircles_.push_back({ circle, color });
+}
+
+void RenderSnapshot::SetDebug(Level* level, std::shared_ptr<Shader> shader, const glm::mat4& viewProjection) {
+    debugLevel_ = level;
+    debugShader_ = std::move(shader);
+    debugViewProjection_ = viewProjection;
+}
+
+void RenderSnapshot::Draw() {
+    for (std::size_t i = 0; i < viewCount_; ++i) {
+        FrameUniforms::SetViewProjection(views_[i].viewProjection);
+        views_[i].queue.Execute();
+    }
+
+    if (!debugLevel_ || !debugShader_) return;
+    FrameUniforms::SetViewProjection(debugViewProjection_);
+    for (const DebugCircle& c : debugCircles_)
+        DrawDebugCircle(c.circle, c.color, debugShader_);
+    debugLevel_->DrawDebugGrid(debugGrid_);
+}
+
+void FramePipeline::Start(SimulateFn simulate, SnapshotFn snapshot) {
+    Stop();
+    simulate_ = std::move(simulate);
+    snapshot_ = std::move(snapshot);
+    running_ = true;
+    worker_ = std::thread(&FramePipeline::WorkerLoop, this);
+    LOG_INFO("⏩ Frame pipeline on, latency bound %.0f ms", config_.maxLatencyMs);
+}
+
+void FramePipeline::Stop() {
+    if (!worker_.joinable()) return;
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void FramePipeline::Kick(double inputTime, float dt, float frameMs) {
+    // One stage in flight at most: the back snapshot is the only spare
+    Wait();
+
+    smoothedFrameMs_ = smoothedFrameMs_ > 0.0f
+        ? smoothedFrameMs_ + (frameMs - smoothedFrameMs_) * 0.1f
+        : frameMs;
+    overlapping_ = config_.maxLatencyMs <= 0.0f || 2.0f * smoothedFrameMs_ <= config_.maxLatencyMs;
+
+    inputTime_ = inputTime;
+    dt_ = dt;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_ = true;
+        done_ = false;
+    }
+    cv_.notify_all();
+
+    if (!overlapping_)
+        Wait();
+}
+
+void FramePipeline::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!busy_) return;
+    cv_.wait(lock, [this] { return done_; });
+    busy_ = false;
+    front_ ^= 1;
+}
+
+void FramePipeline::WorkerLoop() {
+    Log::RegisterThread();
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return !running_ || (busy_ && !done_); });
+        if (!running_) return;
+
+        // The GL thread leaves the back snapshot and the simulation alone
+        // until Wait, so neither needs the lock
+        lock.unlock();
+        simulate_(inputTime_, dt_);
+        snapshot_(snapshots_[front_ ^ 1]);
+        lock.lock();
+
+        done_ = true;
+        cv_.notify_all();
+    }
+}
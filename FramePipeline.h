@@ -0,0 +1,132 @@
+// FramePipeline.h
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Collision.h"
+#include "RenderQueue.h"
+#include "TileMap.h"
+
+class Level;
+class Shader;
+
+// Everything needed to draw one frame of the world, taken after the
+// simulation's last tick: one sprite queue per view (the active level and
+// each visible streamed neighbour) plus the debug overlay. Drawing it
+// reads no simulation state, so the next frame can simulate meanwhile.
+// The GPU resources the commands point at only change when levels load or
+// stream, which is why a snapshot remembers the revision it was built at.
+class RenderSnapshot {
+public:
+	// Empties the snapshot for a rebuild at revision
+	void Reset(std::uint64_t revision);
+	std::uint64_t GetRevision() const { return revision_; }
+
+	// A new view drawn with viewProjection; submit its sprites into the queue
+	RenderQueue& AddView(const glm::mat4& viewProjection);
+	void AddDebugCircle(const Circle& circle, const glm::vec3& color);
+	// The level whose grid and circles the debug overlay draws
+	void SetDebug(Level* level, std::shared_ptr<Shader> shader, const glm::mat4& viewProjection);
+	// The grid's tile state, filled when snapshotting; the level's own tiles
+	// may change while the snapshot is drawn
+	DebugTileGrid& GetDebugGrid() { return debugGrid_; }
+
+	// Draws every view in order, then the debug overlay. GL thread only.
+	void Draw();
+
+private:
+	struct View {
+		glm::mat4 viewProjection{ 1.0f };
+		RenderQueue queue;
+	};
+	struct DebugCircle {
+		Circle circle;
+		glm::vec3 color;
+	};
+
+	std::uint64_t revision_ = ~0ull;
+	// Views are kept across frames so their queues reuse storage
+	std::vector<View> views_;
+	std::size_t viewCount_ = 0;
+
+	Level* debugLevel_ = nullptr;
+	std::shared_ptr<Shader> debugShader_;
+	glm::mat4 debugViewProjection_{ 1.0f };
+	std::vector<DebugCircle> debugCircles_;
+	DebugTileGrid debugGrid_;
+};
+
+// maxLatencyMs bounds input-to-screen latency. Overlapping the stages
+// shows a frame one frame later, so the pipeline only overlaps while two
+// (smoothed) frame times fit in the bound; otherwise it waits for each
+// simulation stage before drawing. 0 = no bound.
+struct FramePipelineConfig {
+	bool enabled = false;
+	float maxLatencyMs = 50.0f;
+};
+
+// Two-stage frame pipeline. The simulation of frame N+1 runs on its own
+// thread while the GL thread draws frame N from a RenderSnapshot; the two
+// snapshots are double buffered, so a frame costs the slower stage rather
+// than both. A stage applies the key events stamped up to the time it was
+// kicked off with (InputSystem's queue is lock-free). GL work the
+// simulation asks for (level loads, streaming) waits for the GL thread
+// between stages, see LevelManager::SetDeferGLWork.
+class FramePipeline {
+public:
+	// Runs the ticks of one frame: dt seconds, input up to inputTime
+	using SimulateFn = std::function<void(double inputTime, float dt)>;
+	// Fills a snapshot from the simulation state
+	using SnapshotFn = std::function<void(RenderSnapshot& out)>;
+
+	explicit FramePipeline(const FramePipelineConfig& config = {}) : config_(config) { }
+	~FramePipeline() { Stop(); }
+	FramePipeline(const FramePipeline&) = delete;
+	FramePipeline& operator=(const FramePipeline&) = delete;
+
+	void Start(SimulateFn simulate, SnapshotFn snapshot);
+	void Stop();
+
+	// Starts simulating the next frame and snapshotting it. frameMs is the
+	// last frame time, for the latency bound; when that rules out
+	// overlapping, Kick waits for the stage.
+	void Kick(double inputTime, float dt, float frameMs);
+	// Blocks until the stage is done and makes its snapshot the front one
+	void Wait();
+
+	// What the GL thread draws this frame
+	RenderSnapshot& Front() { return snapshots_[front_]; }
+	// Whether the last Kick left the stage running behind the render
+	bool IsOverlapping() const { return overlapping_; }
+	const FramePipelineConfig& GetConfig() const { return config_; }
+
+private:
+	void WorkerLoop();
+
+	FramePipelineConfig config_;
+	SimulateFn simulate_;
+	SnapshotFn snapshot_;
+
+	std::array<RenderSnapshot, 2> snapshots_;
+	std::size_t front_ = 0;
+	double inputTime_ = 0.0;
+	float dt_ = 0.0f;
+	float smoothedFrameMs_ = 0.0f;
+	bool overlapping_ = false;
+
+	std::thread worker_;
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool busy_ = false;       // a stage is kicked and not yet waited for
+	bool done_ = false;       // the worker finished it
+	bool running_ = false;
+};
@@ -0,0 +1,72 @@
+// FrameUniforms.cpp
+#include "FrameUniforms.h"
+
+#include <cstddef>
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "GLState.h"
+
+namespace {
+    // Mirrors the std140 layout of the GLSL block
+    struct FrameBlock {
+        glm::mat4 viewProjection{ 1.0f };
+        glm::mat4 screenProjection{ 1.0f };
+        glm::vec4 resolution{ 0.0f };
+        glm::vec4 internalResolution{ 0.0f };
+        float time = 0.0f;
+        float padding[3] = {};
+    };
+    static_assert(sizeof(FrameBlock) == 176);
+    static_assert(offsetof(FrameBlock, screenProjection) == 64);
+    static_assert(offsetof(FrameBlock, resolution) == 128);
+    static_assert(offsetof(FrameBlock, internalResolution) == 144);
+    static_assert(offsetof(FrameBlock, time) == 160);
+
+    glm::vec4 PackResolution(float width, float height) {
+        return glm::vec4(width, height, width > 0.0f ? 1.0f / width : 0.0f, height > 0.0f ? 1.0f / height : 0.0f);
+    }
+
+    FrameBlock block;
+    GLuint ubo = 0;
+}
+
+void FrameUniforms::Init() {
+    if (ubo) return;
+    glGenBuffers(1, &ubo);
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameBlock), &block, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BindingPoint, ubo);
+}
+
+void FrameUniforms::Shutdown() {
+    if (!ubo) return;
+    GLState::ForgetBuffer(ubo);
+    glDeleteBuffers(1, &ubo);
+    ubo = 0;
+}
+
+void FrameUniforms::BeginFrame(float time, float width, float height, glm::vec2 internalSize) {
+    if (!ubo) return;
+    block.screenProjection = glm::ortho(0.0f, width, height, 0.0f);
+    block.resolution = PackResolution(width, height);
+    block.internalResolution = PackResolution(internalSize.x, internalSize.y);
+    block.time = time;
+
+    // Everything after viewProjection; that one is written as levels draw
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, offsetof(FrameBlock, screenProjection),
+                    sizeof(FrameBlock) - offsetof(FrameBlock, screenProjection), &block.screenProjection);
+}
+
+void FrameUniforms::SetViewProjection(const glm::mat4& viewProjection) {
+    if (!ubo || block.viewProjection == viewProjection) return;
+    block.viewProjection = viewProjection;
+    GLState::BindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, offsetof(FrameBlock, viewProjection), sizeof(glm::mat4), &block.viewProjection);
+}
+
+const glm::mat4& FrameUniforms::GetViewProjection() {
+    return block.viewProjection;
+}
@@ -0,0 +1,34 @@
+// FrameUniforms.h
+#pragma once
+
+#include <glm/glm.hpp>
+
+// The per-frame std140 uniform block shared by the sprite, line, text and
+// nuklear shaders:
+//
+//   layout (std140) uniform Frame {
+//       mat4 viewProjection;    // world -> clip for the level being drawn
+//       mat4 screenProjection;  // framebuffer pixels -> clip, origin top-left
+//       vec4 resolution;        // width, height, 1/width, 1/height
+//       vec4 internalResolution; // the level's internal width/height, same packing
+//       float time;             // seconds since start
+//   };
+//
+// Draws no longer upload a projection each; the block is written once per
+// frame, plus once per streamed neighbour whose view is offset.
+// Shader::Compile ties every program's "Frame" block to BindingPoint.
+class FrameUniforms {
+public:
+	static constexpr unsigned int BindingPoint = 0;
+
+	// Creates the buffer and binds it to BindingPoint; needs a GL context
+	static void Init();
+	static void Shutdown();
+
+	// Screen projection, framebuffer and internal (level) resolution and
+	// time for this frame
+	static void BeginFrame(float time, float width, float height, glm::vec2 internalSize);
+	// The world view-projection following draws use; skips unchanged uploads
+	static void SetViewProjection(const glm::mat4& viewProjection);
+	static const glm::mat4& GetViewProjection();
+};
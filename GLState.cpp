@@ -0,0 +1,146 @@
+// GLState.cpp
+#include "GLState.h"
+
+#include <glad/glad.h>
+
+#include "Stats.h"
+
+namespace {
+    // Never a valid GL name or enum, so the first call after Invalidate
+    // always goes through
+    constexpr unsigned int Unknown = ~0u;
+
+    enum BufferSlot { ArrayBuffer, ElementBuffer, UniformBuffer, BufferSlotCount };
+    enum Capability { Blend, DepthTest, CullFace, ScissorTest, CapabilityCount };
+
+    struct Shadow {
+        unsigned int program = Unknown;
+        unsigned int activeUnit = Unknown;
+        unsigned int textures[GLState::TextureUnits];
+        unsigned int vao = Unknown;
+        unsigned int buffers[BufferSlotCount];
+        unsigned int capabilities[CapabilityCount];   // 0/1, or Unknown
+        unsigned int blendSrc = Unknown, blendDst = Unknown;
+        int scissor[4] = { -1, -1, -1, -1 };
+        bool scissorKnown = false;
+
+        Shadow() {
+            for (auto& t : textures) t = Unknown;
+            for (auto& b : buffers) b = Unknown;
+            for (auto& c : capabilities) c = Unknown;
+        }
+    };
+    Shadow shadow;
+
+    // True (and counted as a change) when value differs from the shadow
+    bool Changes(unsigned int& current, unsigned int value) {
+        if (current == value) {
+            Stats::Add(StatCounter::StateSkipped);
+            return false;
+        }
+        current = value;
+        Stats::Add(StatCounter::StateChanges);
+        return true;
+    }
+
+    int SlotOf(unsigned int target) {
+        switch (target) {
+        case GL_ARRAY_BUFFER: return ArrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER: return ElementBuffer;
+        case GL_UNIFORM_BUFFER: return UniformBuffer;
+        default: return -1;
+        }
+    }
+
+    void SetCapability(Capability cap, GLenum glCap, bool enabled) {
+        if (!Changes(shadow.capabilities[cap], enabled ? 1u : 0u)) return;
+        if (enabled) glEnable(glCap);
+        else glDisable(glCap);
+    }
+}
+
+void GLState::Invalidate() {
+    shadow = Shadow{};
+}
+
+void GLState::UseProgram(unsigned int program) {
+    if (Changes(shadow.program, program))
+        glUseProgram(program);
+}
+
+void GLState::BindTexture(unsigned int texture, int unit) {
+    if (shadow.textures[unit] == texture) {
+        Stats::Add(StatCounter::StateSkipped);
+        return;
+    }
+    if (Changes(shadow.activeUnit, static_cast<unsigned int>(unit)))
+        glActiveTexture(GL_TEXTURE0 + unit);
+    Changes(shadow.textures[unit], texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLState::BindVertexArray(unsigned int vao) {
+    if (!Changes(shadow.vao, vao)) return;
+    glBindVertexArray(vao);
+    shadow.buffers[ElementBuffer] = Unknown;
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer) {
+    int slot = SlotOf(target);
+    if (slot < 0) {
+        glBindBuffer(target, buffer);
+        Stats::Add(StatCounter::StateChanges);
+        return;
+    }
+    if (Changes(shadow.buffers[slot], buffer))
+        glBindBuffer(target, buffer);
+}
+
+void GLState::SetBlend(bool enabled) { SetCapability(Blend, GL_BLEND, enabled); }
+void GLState::SetDepthTest(bool enabled) { SetCapability(DepthTest, GL_DEPTH_TEST, enabled); }
+void GLState::SetCullFace(bool enabled) { SetCapability(CullFace, GL_CULL_FACE, enabled); }
+void GLState::SetScissorTest(bool enabled) { SetCapability(ScissorTest, GL_SCISSOR_TEST, enabled); }
+
+void GLState::BlendFunc(unsigned int src, unsigned int dst) {
+    if (shadow.blendSrc == src && shadow.blendDst == dst) {
+        Stats::Add(StatCounter::StateSkipped);
+        return;
+    }
+    shadow.blendSrc = src;
+    shadow.blendDst = dst;
+    glBlendFunc(src, dst);
+    Stats::Add(StatCounter::StateChanges);
+}
+
+void GLState::Scissor(int x, int y, int width, int height) {
+    int* s = shadow.scissor;
+    if (shadow.scissorKnown && s[0] == x && s[1] == y && s[2] == width && s[3] == height) {
+        Stats::Add(StatCounter::StateSkipped);
+        return;
+    }
+    s[0] = x; s[1] = y; s[2] = width; s[3] = height;
+    shadow.scissorKnown = true;
+    glScissor(x, y, width, height);
+    Stats::Add(StatCounter::StateChanges);
+}
+
+void GLState::ForgetProgram(unsigned int program) {
+    if (shadow.program == program) shadow.program = Unknown;
+}
+
+void GLState::ForgetTexture(unsigned int texture) {
+    for (auto& t : shadow.textures)
+        if (t == texture) t = Unknown;
+}
+
+void GLState::ForgetVertexArray(unsigned int vao) {
+    if (shadow.vao == vao) {
+        shadow.vao = Unknown;
+        shadow.buffers[ElementBuffer] = Unknown;
+    }
+}
+
+void GLState::ForgetBuffer(unsigned int buffer) {
+    for (auto& b : shadow.buffers)
+        if (b == buffer) b = Unknown;
+}
@@ -0,0 +1,44 @@
+// GLState.h
+#pragma once
+
+#include <cstdint>
+
+// Shadow of the GL bindings and fixed-function state the renderer uses.
+// Each setter compares against what it last issued and skips the GL call
+// when nothing would change. Issued calls count as StateChanges, skipped
+// ones as StateSkipped, so the overlay shows the driver-call overhead of
+// a frame.
+//
+// Static like Stats and ResourceManager: there is one context and it is
+// only touched from the GL thread. The shadow is only right while all
+// state goes through here; call Invalidate after code that sets GL state
+// directly, and the Forget* functions when deleting objects (GL resets a
+// deleted object's bindings to 0).
+class GLState {
+public:
+	static constexpr int TextureUnits = 8;
+
+	// Forget everything; the next call of each setter always reaches GL
+	static void Invalidate();
+
+	static void UseProgram(unsigned int program);
+	// Binds a GL_TEXTURE_2D on unit (switching the active unit if needed)
+	static void BindTexture(unsigned int texture, int unit = 0);
+	static void BindVertexArray(unsigned int vao);
+	// GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER or GL_UNIFORM_BUFFER. The
+	// element buffer belongs to the bound VAO, so it is re-issued after a
+	// VAO switch.
+	static void BindBuffer(unsigned int target, unsigned int buffer);
+
+	static void SetBlend(bool enabled);
+	static void BlendFunc(unsigned int src, unsigned int dst);
+	static void SetDepthTest(bool enabled);
+	static void SetCullFace(bool enabled);
+	static void SetScissorTest(bool enabled);
+	static void Scissor(int x, int y, int width, int height);
+
+	static void ForgetProgram(unsigned int program);
+	static void ForgetTexture(unsigned int texture);
+	static void ForgetVertexArray(unsigned int vao);
+	static void ForgetBuffer(unsigned int buffer);
+};
@@ -0,0 +1,375 @@
+// HierarchicalPathfinder.cpp
+#include "HierarchicalPathfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    constexpr float Infinity = std::numeric_limits<float>::infinity();
+    constexpr float DiagonalCost = 1.41421356f;
+    // Gaps at least this wide get an entrance at each end instead of one in the middle
+    constexpr int WideEntrance = 6;
+
+    constexpr int stepX[] = { 1, -1, 0,  0, 1, -1,  1, -1 };
+    constexpr int stepY[] = { 0,  0, 1, -1, 1,  1, -1, -1 };
+
+    float Octile(glm::ivec2 a, glm::ivec2 b) {
+        int dx = std::abs(a.x - b.x);
+        int dy = std::abs(a.y - b.y);
+        return static_cast<float>(std::max(dx, dy)) + (DiagonalCost - 1.0f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    struct HeapGreater {
+        template <typename T>
+        bool operator()(const T& a, const T& b) const { return a.f > b.f; }
+    };
+
+    std::uint64_t Key(int a, int b) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) | static_cast<std::uint32_t>(b);
+    }
+}
+
+void HierarchicalPathfinder::Build(const NavGrid* grid, int clusterSize) {
+    Clear();
+    grid_ = grid;
+    if (!grid_ || grid_->Empty()) return;
+
+    clusterSize_ = std::max(clusterSize, 2);
+    clustersX_ = (grid_->GetWidth() + clusterSize_ - 1) / clusterSize_;
+    clustersY_ = (grid_->GetHeight() + clusterSize_ - 1) / clusterSize_;
+    int clusters = clustersX_ * clustersY_;
+
+    clusterNodes_.assign(clusters, {});
+    borderNodes_.assign(static_cast<std::size_t>(clusters) * 2, {});
+
+    std::size_t localCells = static_cast<std::size_t>(clusterSize_) * clusterSize_;
+    localDist_.assign(localCells, Infinity);
+    localParent_.assign(localCells, -1);
+    localStamp_.assign(localCells, 0);
+    localSearch_ = 0;
+
+    for (int border = 0; border < clusters * 2; ++border)
+        BuildBorder(border);
+    for (int cluster = 0; cluster < clusters; ++cluster)
+        BuildIntraEdges(cluster);
+}
+
+void HierarchicalPathfinder::Clear() {
+    grid_ = nullptr;
+    clustersX_ = clustersY_ = 0;
+    nodes_.clear();
+    freeNodes_.clear();
+    clusterNodes_.clear();
+    borderNodes_.clear();
+    stepCache_.clear();
+}
+
+void HierarchicalPathfinder::OnTileChanged(int x, int y) {
+    if (!grid_ || !grid_->InBounds(x, y)) return;
+
+    int cx = x / clusterSize_;
+    int cy = y / clusterSize_;
+    int cluster = cy * clustersX_ + cx;
+
+    // The four borders of this cluster...
+    int borders[4];
+    int borderCount = 0;
+    borders[borderCount++] = cluster * 2;
+    borders[borderCount++] = cluster * 2 + 1;
+    if (cx > 0) borders[borderCount++] = (cluster - 1) * 2;
+    if (cy > 0) borders[borderCount++] = (cluster - clustersX_) * 2 + 1;
+    for (int i = 0; i < borderCount; ++i) {
+        ClearBorder(borders[i]);
+        BuildBorder(borders[i]);
+    }
+
+    // ...and every cluster that shares one of them
+    BuildIntraEdges(cluster);
+    if (cx > 0) BuildIntraEdges(cluster - 1);
+    if (cx + 1 < clustersX_) BuildIntraEdges(cluster + 1);
+    if (cy > 0) BuildIntraEdges(cluster - clustersX_);
+    if (cy + 1 < clustersY_) BuildIntraEdges(cluster + clustersX_);
+
+    stepCache_.clear();
+}
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::ClusterRect(int cluster) const {
+    int x0 = (cluster % clustersX_) * clusterSize_;
+    int y0 = (cluster / clustersX_) * clusterSize_;
+    return { x0, y0, std::min(x0 + clusterSize_, grid_->GetWidth()), std::min(y0 + clusterSize_, grid_->GetHeight()) };
+}
+
+int HierarchicalPathfinder::AddNode(int cell, int cluster) {
+    int id;
+    if (!freeNodes_.empty()) {
+        id = freeNodes_.back();
+        freeNodes_.pop_back();
+    } else {
+        id = static_cast<int>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Node& node = nodes_[id];
+    node.cell = cell;
+    node.cluster = cluster;
+    node.alive = true;
+    node.edges.clear();
+    clusterNodes_[cluster].push_back(id);
+    return id;
+}
+
+void HierarchicalPathfinder::RemoveNode(int id) {
+    Node& node = nodes_[id];
+    for (const Edge& e : node.edges) {
+        auto& back = nodes_[e.to].edges;
+        back.erase(std::remove_if(back.begin(), back.end(), [id](const Edge& b) { return b.to == id; }), back.end());
+    }
+    node.edges.clear();
+    node.alive = false;
+
+    auto& members = clusterNodes_[node.cluster];
+    members.erase(std::remove(members.begin(), members.end(), id), members.end());
+    freeNodes_.push_back(id);
+}
+
+void HierarchicalPathfinder::ClearBorder(int border) {
+    for (int id : borderNodes_[border])
+        RemoveNode(id);
+    borderNodes_[border].clear();
+}
+
+void HierarchicalPathfinder::BuildBorder(int border) {
+    int cluster = border / 2;
+    bool bottom = (border % 2) == 1;
+    int cx = cluster % clustersX_;
+    int cy = cluster / clustersX_;
+    if (bottom ? cy + 1 >= clustersY_ : cx + 1 >= clustersX_) return;
+
+    int other = bottom ? cluster + clustersX_ : cluster + 1;
+    Rect rect = ClusterRect(cluster);
+
+    // Walk along the border; each run open on both sides is one entrance
+    int length = bottom ? rect.x1 - rect.x0 : rect.y1 - rect.y0;
+    auto sides = [&](int i, glm::ivec2& a, glm::ivec2& b) {
+        a = bottom ? glm::ivec2(rect.x0 + i, rect.y1 - 1) : glm::ivec2(rect.x1 - 1, rect.y0 + i);
+        b = bottom ? glm::ivec2(a.x, a.y + 1) : glm::ivec2(a.x + 1, a.y);
+    };
+    auto addEntrance = [&](int i) {
+        glm::ivec2 a, b;
+        sides(i, a, b);
+        int na = AddNode(grid_->Index(a.x, a.y), cluster);
+        int nb = AddNode(grid_->Index(b.x, b.y), other);
+        nodes_[na].edges.push_back({ nb, 1.0f, true });
+        nodes_[nb].edges.push_back({ na, 1.0f, true });
+        borderNodes_[border].push_back(na);
+        borderNodes_[border].push_back(nb);
+    };
+
+    int runStart = -1;
+    for (int i = 0; i <= length; ++i) {
+        bool open = false;
+        if (i < length) {
+            glm::ivec2 a, b;
+            sides(i, a, b);
+            open = !grid_->IsBlocked(a.x, a.y) && !grid_->IsBlocked(b.x, b.y);
+        }
+        if (open && runStart < 0) runStart = i;
+        if (!open && runStart >= 0) {
+            int runLength = i - runStart;
+            if (runLength >= WideEntrance) {
+                addEntrance(runStart);
+                addEntrance(i - 1);
+            } else {
+                addEntrance(runStart + runLength / 2);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::BuildIntraEdges(int cluster) {
+    const std::vector<int>& members = clusterNodes_[cluster];
+    for (int id : members) {
+        auto& edges = nodes_[id].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge& e) { return !e.inter; }), edges.end());
+    }
+
+    Rect rect = ClusterRect(cluster);
+    for (int a : members) {
+        LocalSearch(grid_->CellOf(nodes_[a].cell), rect);
+        for (int b : members) {
+            if (a == b) continue;
+            float d = LocalDistance(grid_->CellOf(nodes_[b].cell));
+            if (d < Infinity)
+                nodes_[a].edges.push_back({ b, d, false });
+        }
+    }
+}
+
+void HierarchicalPathfinder::LocalSearch(glm::ivec2 start, const Rect& rect) {
+    localRect_ = rect;
+    int width = rect.x1 - rect.x0;
+    auto local = [&](glm::ivec2 c) { return (c.y - rect.y0) * width + (c.x - rect.x0); };
+
+    if (++localSearch_ == 0) {
+        std::fill(localStamp_.begin(), localStamp_.end(), 0);
+        localSearch_ = 1;
+    }
+
+    open_.clear();
+    int s = local(start);
+    localDist_[s] = 0.0f;
+    localParent_[s] = -1;
+    localStamp_[s] = localSearch_;
+    open_.push_back({ 0.0f, s });
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), HeapGreater{});
+        OpenEntry top = open_.back();
+        open_.pop_back();
+        if (top.f > localDist_[top.node]) continue;
+
+        glm::ivec2 cell(rect.x0 + top.node % width, rect.y0 + top.node / width);
+        for (int n = 0; n < 8; ++n) {
+            glm::ivec2 next(cell.x + stepX[n], cell.y + stepY[n]);
+            if (!rect.Contains(next) || grid_->IsBlocked(next.x, next.y)) continue;
+            if (n >= 4 && (grid_->IsBlocked(next.x, cell.y) || grid_->IsBlocked(cell.x, next.y))) continue;
+
+            int ni = local(next);
+            float d = top.f + (n >= 4 ? DiagonalCost : 1.0f);
+            if (localStamp_[ni] == localSearch_ && d >= localDist_[ni]) continue;
+            localStamp_[ni] = localSearch_;
+            localDist_[ni] = d;
+            localParent_[ni] = top.node;
+            open_.push_back({ d, ni });
+            std::push_heap(open_.begin(), open_.end(), HeapGreater{});
+        }
+    }
+}
+
+float HierarchicalPathfinder::LocalDistance(glm::ivec2 cell) const {
+    if (!localRect_.Contains(cell)) return Infinity;
+    int i = (cell.y - localRect_.y0) * (localRect_.x1 - localRect_.x0) + (cell.x - localRect_.x0);
+    return localStamp_[i] == localSearch_ ? localDist_[i] : Infinity;
+}
+
+bool HierarchicalPathfinder::FindRoute(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& waypoints) {
+    waypoints.clear();
+    if (!grid_ || grid_->IsBlocked(start.x, start.y) || grid_->IsBlocked(goal.x, goal.y))
+        return false;
+
+    int startCluster = ClusterOf(start);
+    int goalCluster = ClusterOf(goal);
+
+    // Same cluster and connected inside it: no abstract search needed
+    LocalSearch(start, ClusterRect(startCluster));
+    if (startCluster == goalCluster && LocalDistance(goal) < Infinity) {
+        waypoints.push_back(goal);
+        return true;
+    }
+
+    // Temporary start/goal links into the entrance graph
+    const std::size_t n = nodes_.size();
+    startCost_.assign(n, Infinity);
+    for (int id : clusterNodes_[startCluster])
+        startCost_[id] = LocalDistance(grid_->CellOf(nodes_[id].cell));
+    LocalSearch(goal, ClusterRect(goalCluster));
+    goalCost_.assign(n, Infinity);
+    for (int id : clusterNodes_[goalCluster])
+        goalCost_[id] = LocalDistance(grid_->CellOf(nodes_[id].cell));
+
+    // A* over entrances; node n is the goal itself
+    const int goalNode = static_cast<int>(n);
+    if (g_.size() < n + 1) {
+        g_.resize(n + 1);
+        parent_.resize(n + 1);
+        visited_.resize(n + 1, 0);
+        closed_.resize(n + 1, 0);
+    }
+    if (++stamp_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        stamp_ = 1;
+    }
+
+    open_.clear();
+    auto relax = [&](int node, float g, int from, float h) {
+        if (visited_[node] == stamp_ && g >= g_[node]) return;
+        visited_[node] = stamp_;
+        g_[node] = g;
+        parent_[node] = from;
+        open_.push_back({ g + h, node });
+        std::push_heap(open_.begin(), open_.end(), HeapGreater{});
+    };
+    for (int id : clusterNodes_[startCluster])
+        if (startCost_[id] < Infinity)
+            relax(id, startCost_[id], -1, Octile(grid_->CellOf(nodes_[id].cell), goal));
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), HeapGreater{});
+        int node = open_.back().node;
+        open_.pop_back();
+        if (closed_[node] == stamp_) continue;
+        closed_[node] = stamp_;
+        if (node == goalNode) break;
+
+        if (goalCost_[node] < Infinity)
+            relax(goalNode, g_[node] + goalCost_[node], node, 0.0f);
+        for (const Edge& e : nodes_[node].edges)
+            if (closed_[e.to] != stamp_)
+                relax(e.to, g_[node] + e.cost, node, Octile(grid_->CellOf(nodes_[e.to].cell), goal));
+    }
+
+    if (closed_[goalNode] != stamp_) return false;
+
+    for (int node = parent_[goalNode]; node >= 0; node = parent_[node]) {
+        glm::ivec2 cell = grid_->CellOf(nodes_[node].cell);
+        if (waypoints.empty() || waypoints.back() != cell)
+            waypoints.push_back(cell);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    if (waypoints.empty() || waypoints.back() != goal)
+        waypoints.push_back(goal);
+    return true;
+}
+
+bool HierarchicalPathfinder::NextStep(glm::ivec2 start, glm::ivec2 goal, glm::ivec2& next) {
+    if (!grid_ || !grid_->InBounds(start.x, start.y) || !grid_->InBounds(goal.x, goal.y))
+        return false;
+
+    const glm::ivec2 NoStep(-1, -1);
+    std::uint64_t key = Key(grid_->Index(start.x, start.y), grid_->Index(goal.x, goal.y));
+    auto it = stepCache_.find(key);
+    if (it != stepCache_.end()) {
+        next = it->second;
+        return next != NoStep;
+    }
+    if (stepCache_.size() >= MaxCachedSteps)
+        stepCache_.clear();
+
+    glm::ivec2 result = NoStep;
+    std::vector<glm::ivec2> route;
+    if (FindRoute(start, goal, route)) {
+        auto target = std::find_if(route.begin(), route.end(), [&](glm::ivec2 c) { return c != start; });
+        if (target == route.end()) {
+            result = start;
+        } else if (std::abs(target->x - start.x) <= 1 && std::abs(target->y - start.y) <= 1) {
+            result = *target;
+        } else {
+            // Refine just the first leg, which stays inside the start cluster
+            Rect rect = ClusterRect(ClusterOf(start));
+            LocalSearch(start, rect);
+            if (LocalDistance(*target) < Infinity) {
+                int width = rect.x1 - rect.x0;
+                int node = (target->y - rect.y0) * width + (target->x - rect.x0);
+                while (localParent_[node] >= 0 && localParent_[localParent_[node]] >= 0)
+                    node = localParent_[node];
+                result = glm::ivec2(rect.x0 + node % width, rect.y0 + node / width);
+            }
+        }
+    }
+
+    stepCache_[key] = result;
+    next = result;
+    return result != NoStep;
+}
@@ -0,0 +1,95 @@
+// HierarchicalPathfinder.h
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "NavGrid.h"
+
+// HPA*: the NavGrid is cut into square clusters. Walkable gaps along each
+// cluster border become entrances (a node on either side), and the
+// distances between the entrances of a cluster are precomputed. A query
+// searches only this small graph, then refines the first leg inside the
+// start cluster, so its cost tracks the number of clusters rather than
+// the number of tiles.
+//
+// Call OnTileChanged after editing the NavGrid; only the borders and
+// clusters around that tile are rebuilt. Not thread-safe.
+class HierarchicalPathfinder {
+public:
+	void Build(const NavGrid* grid, int clusterSize = 16);
+	void Clear();
+	void OnTileChanged(int x, int y);
+
+	// Coarse route: entrance cells from start towards goal, ending with goal
+	bool FindRoute(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2>& waypoints);
+
+	// The neighbouring cell to step into from start; cached per (start, goal)
+	bool NextStep(glm::ivec2 start, glm::ivec2 goal, glm::ivec2& next);
+
+	int GetClusterSize() const { return clusterSize_; }
+	std::size_t GetNodeCount() const { return nodes_.size() - freeNodes_.size(); }
+
+	static constexpr std::size_t MaxCachedSteps = 1024;
+
+private:
+	struct Edge {
+		int to;
+		float cost;
+		bool inter;   // crosses to the neighbouring cluster
+	};
+	struct Node {
+		int cell = -1;
+		int cluster = -1;
+		bool alive = false;
+		std::vector<Edge> edges;
+	};
+	struct Rect {
+		int x0, y0, x1, y1;   // inclusive-exclusive
+		bool Contains(glm::ivec2 c) const { return c.x >= x0 && c.y >= y0 && c.x < x1 && c.y < y1; }
+	};
+
+	int ClusterOf(glm::ivec2 cell) const { return (cell.y / clusterSize_) * clustersX_ + cell.x / clusterSize_; }
+	Rect ClusterRect(int cluster) const;
+
+	int AddNode(int cell, int cluster);
+	void RemoveNode(int node);
+	// border = cluster * 2 + (0: right edge, 1: bottom edge)
+	void BuildBorder(int border);
+	void ClearBorder(int border);
+	void BuildIntraEdges(int cluster);
+
+	// Dijkstra from start limited to rect; fills localDist_/localParent_
+	void LocalSearch(glm::ivec2 start, const Rect& rect);
+	float LocalDistance(glm::ivec2 cell) const;
+
+	const NavGrid* grid_ = nullptr;
+	int clusterSize_ = 16;
+	int clustersX_ = 0, clustersY_ = 0;
+
+	std::vector<Node> nodes_;
+	std::vector<int> freeNodes_;
+	std::vector<std::vector<int>> clusterNodes_;
+	std::vector<std::vector<int>> borderNodes_;
+
+	// Local (cluster-sized) search buffers
+	Rect localRect_{ 0, 0, 0, 0 };
+	std::vector<float> localDist_;
+	std::vector<int> localParent_;
+	std::vector<std::uint32_t> localStamp_;
+	std::uint32_t localSearch_ = 0;
+
+	// Abstract search buffers, indexed by node (+2 for start and goal)
+	std::vector<float> g_;
+	std::vector<int> parent_;
+	std::vector<std::uint32_t> visited_, closed_;
+	std::uint32_t stamp_ = 0;
+	struct OpenEntry { float f; int node; };
+	std::vector<OpenEntry> open_;
+	std::vector<float> startCost_, goalCost_;
+
+	std::unordered_map<std::uint64_t, glm::ivec2> stepCache_;
+};
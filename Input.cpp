@@ -0,0 +1,75 @@
+// Input.cpp
+#include "Input.h"
+
+#include <GLFW/glfw3.h>
+
+#include "Log.h"
+
+InputSystem::InputSystem() {
+    bindings_.fill(InputAction::None);
+    tickEvents_.reserve(InputQueue::Capacity);
+
+    Bind(GLFW_KEY_W, InputAction::MoveUp);
+    Bind(GLFW_KEY_S, InputAction::MoveDown);
+    Bind(GLFW_KEY_A, InputAction::MoveLeft);
+    Bind(GLFW_KEY_D, InputAction::MoveRight);
+    Bind(GLFW_KEY_SPACE, InputAction::Bite);
+    Bind(GLFW_KEY_TAB, InputAction::ToggleDebug);
+}
+
+void InputSystem::Bind(int key, InputAction action) {
+    if (key >= 0 && key < KeyCount)
+        bindings_[key] = action;
+}
+
+InputAction InputSystem::GetBinding(int key) const {
+    return key >= 0 && key < KeyCount ? bindings_[key] : InputAction::None;
+}
+
+void InputSystem::OnKey(int key, bool pressed, double time) {
+    if (key < 0 || key >= KeyCount) return;
+    if (!queue_.Push({ time, static_cast<std::uint16_t>(key), pressed })) {
+        // Only the producer touches dropped_
+        if (dropped_++ == 0)
+            LOG_WARN("⌨️ Input queue full, dropping key events");
+    }
+}
+
+void InputSystem::BeginTick(double tickEnd) {
+    ClearEdges();
+    while (const InputEvent* event = queue_.Front()) {
+        if (event->time > tickEnd) break;
+        Apply(*event);
+        queue_.Pop();
+    }
+}
+
+void InputSystem::BeginTick(const std::vector<InputEvent>& events) {
+    ClearEdges();
+    for (const InputEvent& event : events)
+        Apply(event);
+}
+
+void InputSystem::ClearEdges() {
+    actions_.pressed_.fill(false);
+    actions_.released_.fill(false);
+    tickEvents_.clear();
+}
+
+void InputSystem::Apply(const InputEvent& event) {
+    // Repeats and releases of keys that were never down change nothing
+    if (event.key >= KeyCount || keyDown_[event.key] == event.pressed) return;
+    keyDown_[event.key] = event.pressed;
+    tickEvents_.push_back(event);
+
+    InputAction action = bindings_[event.key];
+    if (action == InputAction::None) return;
+    std::size_t a = ActionState::Index(action);
+    if (event.pressed) {
+        ++actions_.held_[a];
+        actions_.pressed_[a] |= !event.silent;
+    } else {
+        if (actions_.held_[a] > 0) --actions_.held_[a];
+        actions_.released_[a] |= !event.silent;
+    }
+}
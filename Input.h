@@ -0,0 +1,124 @@
+// Input.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What the simulation reacts to; keys are bound to these
+enum class InputAction : std::uint8_t {
+	MoveUp,
+	MoveDown,
+	MoveLeft,
+	MoveRight,
+	Bite,
+	ToggleDebug,
+	Count,
+	None = 0xFF
+};
+
+constexpr std::size_t InputActionCount = static_cast<std::size_t>(InputAction::Count);
+
+// One key press or release. time is glfwGetTime() when the callback ran;
+// replayed events carry no time. A silent event changes the key's state
+// without a press/release edge: replays use it for what changed while the
+// game was paused, whose edges the live game never saw.
+struct InputEvent {
+	double time = 0.0;
+	std::uint16_t key = 0;
+	bool pressed = false;
+	bool silent = false;
+};
+
+// Single-producer single-consumer lock-free ring. The GLFW key callback
+// pushes on the GL thread; the simulation pops, on whichever thread it
+// runs (see FramePipeline).
+class InputQueue {
+public:
+	static constexpr std::size_t Capacity = 256;   // power of two
+	static_assert((Capacity & (Capacity - 1)) == 0);
+
+	// Producer. False (event dropped) when full.
+	bool Push(const InputEvent& event) {
+		std::size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == Capacity)
+			return false;
+		buffer_[head & (Capacity - 1)] = event;
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer: the oldest event, or null when empty
+	const InputEvent* Front() const {
+		std::size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail == head_.load(std::memory_order_acquire))
+			return nullptr;
+		return &buffer_[tail & (Capacity - 1)];
+	}
+	void Pop() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+	std::array<InputEvent, Capacity> buffer_{};
+	alignas(64) std::atomic<std::size_t> head_{ 0 };   // written by the producer only
+	alignas(64) std::atomic<std::size_t> tail_{ 0 };   // written by the consumer only
+};
+
+// Per-tick action state. Edges are kept per tick, so a press released
+// again before the tick ran still counts.
+class ActionState {
+public:
+	bool IsHeld(InputAction action) const { return held_[Index(action)] > 0; }
+	// Went down at least once this tick
+	bool WasPressed(InputAction action) const { return pressed_[Index(action)]; }
+	bool WasReleased(InputAction action) const { return released_[Index(action)]; }
+
+private:
+	friend class InputSystem;
+	static std::size_t Index(InputAction action) { return static_cast<std::size_t>(action); }
+
+	std::array<std::uint8_t, InputActionCount> held_{};   // bound keys down
+	std::array<bool, InputActionCount> pressed_{};
+	std::array<bool, InputActionCount> released_{};
+};
+
+// Event-driven input. Key callbacks queue timestamped events; each
+// fixed-step tick applies the events up to its end time, in order, and maps
+// keys to actions. Nothing is sampled, so taps shorter than a frame (or a
+// tick) are never lost.
+class InputSystem {
+public:
+	static constexpr int KeyCount = 1024;
+
+	InputSystem();   // default bindings
+
+	void Bind(int key, InputAction action);
+	InputAction GetBinding(int key) const;
+
+	// Producer side (GLFW callbacks)
+	void OnKey(int key, bool pressed, double time);
+
+	// Consumer side, once per tick: applies the queued events stamped up
+	// to tickEnd (glfwGetTime() seconds)
+	void BeginTick(double tickEnd);
+	// Same, with exactly these events instead of the queue (replays)
+	void BeginTick(const std::vector<InputEvent>& events);
+
+	const ActionState& GetActions() const { return actions_; }
+	// The events the current tick applied, in order
+	const std::vector<InputEvent>& GetTickEvents() const { return tickEvents_; }
+	bool IsKeyDown(int key) const { return key >= 0 && key < KeyCount && keyDown_[key]; }
+
+private:
+	void ClearEdges();
+	void Apply(const InputEvent& event);
+
+	InputQueue queue_;
+	std::array<InputAction, KeyCount> bindings_;
+	// Consumer-side state
+	std::array<bool, KeyCount> keyDown_{};
+	ActionState actions_;
+	std::vector<InputEvent> tickEvents_;
+	std::uint64_t dropped_ = 0;
+};
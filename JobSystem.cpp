@@ -0,0 +1,173 @@
+// JobSystem.cpp
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Log.h"
+
+namespace {
+    struct Task {
+        JobSystem::RangeFn fn;
+        const void* ctx;
+        std::size_t begin, end;
+        std::atomic<std::size_t>* pending;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // queues[0..workers-1] belong to the workers; the last one is shared by
+    // every thread outside the pool (in practice the main thread)
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{false};
+    std::atomic<std::size_t> queued{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+
+    thread_local std::size_t queueIndex = static_cast<std::size_t>(-1);
+
+    std::size_t ThisQueue() {
+        return queueIndex < workers.size() ? queueIndex : queues.size() - 1;
+    }
+
+    void Push(std::size_t q, const Task& task) {
+        // Count first so the counter never dips below the real queue size
+        queued.fetch_add(1, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        queues[q]->tasks.push_back(task);
+    }
+
+    // Own queue newest-first (still warm in cache), then steal oldest-first
+    bool TryGetTask(std::size_t self, Task& out) {
+        if (queued.load(std::memory_order_acquire) == 0) return false;
+
+        {
+            WorkQueue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                out = own.tasks.back();
+                own.tasks.pop_back();
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < queues.size(); ++i) {
+            WorkQueue& victim = *queues[(self + i) % queues.size()];
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || victim.tasks.empty()) continue;
+            out = victim.tasks.front();
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void RunTask(const Task& task) {
+        task.fn(task.ctx, task.begin, task.end);
+        task.pending->fetch_sub(1, std::memory_order_release);
+    }
+
+    void WorkerLoop(std::size_t index) {
+        queueIndex = index;
+        Log::RegisterThread();
+        Task task;
+        while (running.load(std::memory_order_acquire)) {
+            if (TryGetTask(index, task)) {
+                RunTask(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCv.wait(lock, [] {
+                return !running.load(std::memory_order_acquire) || queued.load(std::memory_order_acquire) > 0;
+            });
+        }
+    }
+}
+
+void JobSystem::Init(unsigned int workerCount) {
+    if (running.load()) return;
+
+    if (workerCount == 0) {
+        unsigned int hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 0;
+    }
+
+    queues.clear();
+    for (unsigned int i = 0; i < workerCount + 1; ++i)
+        queues.push_back(std::make_unique<WorkQueue>());
+
+    running.store(true, std::memory_order_release);
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+        workers.emplace_back(WorkerLoop, static_cast<std::size_t>(i));
+
+    LOG_INFO("🧵 Job system started with %u workers", workerCount);
+}
+
+void JobSystem::Shutdown() {
+    if (!running.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCv.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+    queues.clear();
+    queued.store(0);
+}
+
+unsigned int JobSystem::WorkerCount() {
+    return static_cast<unsigned int>(workers.size());
+}
+
+void JobSystem::Dispatch(std::size_t count, std::size_t grain, RangeFn fn, const void* ctx) {
+    if (count == 0) return;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (count + grain - 1) / grain;
+
+    // Not worth (or not able to) go wide: same chunks, run in place
+    if (chunks == 1 || workers.empty() || !running.load(std::memory_order_acquire)) {
+        for (std::size_t begin = 0; begin < count; begin += grain)
+            fn(ctx, begin, std::min(begin + grain, count));
+        return;
+    }
+
+    std::atomic<std::size_t> pending{chunks - 1};
+    std::size_t self = ThisQueue();
+
+    // Spread chunks over the queues so the workers start without stealing;
+    // chunk 0 stays with the caller
+    for (std::size_t c = 1; c < chunks; ++c) {
+        std::size_t begin = c * grain;
+        Push(c % queues.size(), Task{ fn, ctx, begin, std::min(begin + grain, count), &pending });
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCv.notify_all();
+
+    fn(ctx, 0, std::min(grain, count));
+
+    // Help out (with this batch or anyone else's) until ours is finished
+    Task task;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (TryGetTask(self, task))
+            RunTask(task);
+        else
+            std::this_thread::yield();
+    }
+}
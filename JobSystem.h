@@ -0,0 +1,36 @@
+// JobSystem.h
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+// Fixed pool of worker threads with one deque per worker. A worker pops
+// its own newest job and, when empty, steals the oldest job of another
+// worker. The thread that starts a batch helps run it instead of blocking,
+// so calling ParallelFor from the main thread or from a job is fine.
+//
+// Jobs are plain function pointers plus a context pointer; nothing is
+// allocated per job.
+class JobSystem {
+public:
+	// workerCount 0 = hardware threads - 1 (the main thread is the other one)
+	static void Init(unsigned int workerCount = 0);
+	static void Shutdown();
+	static unsigned int WorkerCount();
+
+	// Calls fn(begin, end) over [0, count) in chunks of at most grain items
+	// and returns when all chunks are done. Chunk boundaries depend only on
+	// count and grain, never on timing.
+	template <typename F>
+	static void ParallelFor(std::size_t count, std::size_t grain, F&& fn) {
+		using Fn = std::remove_reference_t<F>;
+		Dispatch(count, grain, [](const void* ctx, std::size_t begin, std::size_t end) {
+			(*static_cast<Fn*>(const_cast<void*>(ctx)))(begin, end);
+		}, &fn);
+	}
+
+	using RangeFn = void (*)(const void* ctx, std::size_t begin, std::size_t end);
+
+private:
+	static void Dispatch(std::size_t count, std::size_t grain, RangeFn fn, const void* ctx);
+};
@@ -5,10 +5,15 @@
 
 #include "Dog.h"
 #include "RESOURCE_MANAGER.h"
-#include "Enemies.h"
+#include "AnimationClip.h"
+#include "EnemyRegistry.h"
+#include <algorithm>
 #include <fstream>
-#include <iostream>
 #include "DebugDraw.h"
+#include "FramePipeline.h"
+#include "FrameUniforms.h"
+#include "Log.h"
+#include "Stats.h"
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
 
@@ -20,145 +25,273 @@ Level::Level(): dog_(nullptr) {
 Level::~Level() { Unload(); }
 
 void Level::Unload() {
-	for (const auto& name : loadedTextureNames)
-		ResourceManager::UnloadTexture(name);
+	ResourceManager::ReleaseAtlasRegions(textureFiles_);
 	for (const auto& name : loadedShaderNames)
 		ResourceManager::UnloadShader(name);
 
-	loadedTextureNames.clear();
+	textures_.clear();
+	textureFiles_.clear();
 	loadedShaderNames.clear();
-	enemies.clear();
+	enemies.Clear();
 	solidTiles.clear();
+	blockTile_ = -1;
+	tileEdits_.clear();
 	tileMap.reset();
 	if (dog_) {
 		dog_.reset();
 	}
 	tileLayers.clear();
+	pathfinder_.SetGrid(nullptr);
+	flowField_.SetGrid(nullptr);
+	hierarchicalPathfinder_.Clear();
+	navGrid_.Clear();
 
 }
-void Level::Load(int index, unsigned int width, unsigned int height) {
-    Unload();
-
-	currentLevel_ = index;
-	transitionCooldown_ = 0.0f;
-
+json Level::ReadData(int index) {
     std::string path = "resources/levels/level" + std::to_string(index) + ".json";
     std::ifstream file(path);
     if (!file) {
-        std::cerr << "Failed to load " << path << "\n";
+        LOG_ERROR("Failed to load %s", path.c_str());
+        return json(json::value_t::discarded);
+    }
+
+    // No exceptions: this also runs on the streaming worker threads
+    json data = json::parse(file, nullptr, false);
+    if (data.is_discarded())
+        LOG_ERROR("❌ %s is not valid JSON", path.c_str());
+    return data;
+}
+
+glm::vec2 Level::ComputeMapSize(const json& data) {
+    glm::vec2 size = { data.value("internalWidth", 496.0f), data.value("internalHeight", 272.0f) };
+    int tileWidth = 16, tileHeight = 16;
+    if (data.contains("tileSize")) {
+        tileWidth = data["tileSize"].value("width", 16);
+        tileHeight = data["tileSize"].value("height", 16);
+    }
+    if (!data.contains("tileLayers")) return size;
+
+    for (const auto& layer : data["tileLayers"]) {
+        if (!layer.contains("tilemap") || !layer["tilemap"].is_array() || layer["tilemap"].empty()) continue;
+        const auto& rows = layer["tilemap"];
+        size = glm::max(size, glm::vec2(rows[0].size() * tileWidth, rows.size() * tileHeight));
+    }
+    return size;
+}
+
+void Level::Load(int index, unsigned int width, unsigned int height, std::uint64_t seed) {
+    json data = ReadData(index);
+    if (data.is_discarded()) {
+        Unload();
         return;
     }
+    Load(data, index, width, height, seed);
+}
 
-    json data;
-    file >> data;
+bool Level::Load(const json& data, int index, unsigned int width, unsigned int height, std::uint64_t seed) {
+    try {
+        LoadData(data, index, width, height, seed);
+    } catch (const json::exception& e) {
+        LOG_ERROR("❌ Level %d has invalid data: %s", index, e.what());
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+void Level::LoadData(const json& data, int index, unsigned int width, unsigned int height, std::uint64_t seed) {
+    Unload();
+
+	currentLevel_ = index;
+	seed_ = seed;
+	transitionCooldown_ = 0.0f;
+	holdTransitions_ = false;
 
     internalWidth = data.value("internalWidth", 496.0f);
     internalHeight = data.value("internalHeight", 272.0f);
-    projection_ = glm::ortho(0.0f, internalWidth, internalHeight, 0.0f);
+
+    CameraConfig cameraConfig;
+    if (data.contains("camera")) {
+        const auto& cam = data.at("camera");
+        cameraConfig.deadzone.x = cam.value("deadzoneX", cameraConfig.deadzone.x);
+        cameraConfig.deadzone.y = cam.value("deadzoneY", cameraConfig.deadzone.y);
+        cameraConfig.smoothing = cam.value("smoothing", cameraConfig.smoothing);
+        cameraConfig.pixelSnap = cam.value("pixelSnap", cameraConfig.pixelSnap);
+    }
+    camera_.SetConfig(cameraConfig);
+    camera_.SetViewport({ internalWidth, internalHeight });
 
     // Load shaders
-    for (auto& [name, shaderInfo] : data["resources"]["shaders"].items()) {
-        ResourceManager::LoadShader(
-            shaderInfo["vert"].get<std::string>().c_str(),
-            shaderInfo["frag"].get<std::string>().c_str(),
-            nullptr,
-            name.c_str()
-        );
-        loadedShaderNames.insert(name);
+    // const json has no operator[] for missing keys: every optional block
+    // is checked with contains, required fields go through at()
+    const json& resources = data.contains("resources") ? data.at("resources") : json::object();
+    if (resources.contains("shaders")) {
+        for (auto& [name, shaderInfo] : resources.at("shaders").items()) {
+            ResourceManager::LoadShader(
+                shaderInfo.at("vert").get<std::string>().c_str(),
+                shaderInfo.at("frag").get<std::string>().c_str(),
+                nullptr,
+                name.c_str()
+            );
+            loadedShaderNames.insert(name);
+        }
     }
 
-    // Load textures
-    for (auto& [name, path] : data["resources"]["textures"].items()) {
-        ResourceManager::LoadTexture(path.get<std::string>().c_str(), name);
-        loadedTextureNames.insert(name);
+    // Load textures, packed into shared atlas pages so entities and tiles
+    // draw from as few textures as possible
+    std::vector<std::string> textureNames;
+    if (resources.contains("textures")) {
+        for (auto& [name, path] : resources.at("textures").items()) {
+            textureNames.push_back(name);
+            textureFiles_.push_back(path.get<std::string>());
+        }
     }
+    std::vector<TextureRegion> regions = ResourceManager::AcquireAtlasRegions(textureFiles_);
+    for (std::size_t i = 0; i < textureNames.size(); ++i)
+        textures_[textureNames[i]] = regions[i];
 
     // Shared shader and texture
     auto shader = ResourceManager::GetShader("sprite");
-    auto tileTex = ResourceManager::GetTexture("tilemap");
+    const TextureRegion& tileTex = GetTextureRegion("tilemap");
     auto sharedText = ResourceManager::GetTextRendererPtr("default");
 	debugShader_ = ResourceManager::GetShader("grid"); // Or whatever debug shader you use
 
 
-    int tileWidth = data["tileSize"].value("width", 16);
-    int tileHeight = data["tileSize"].value("height", 16);
-    int mapWidth = data["levelSize"].value("width", 224);
-    int mapHeight = data["levelSize"].value("height", 240);
+    int tileWidth = 16, tileHeight = 16;
+    if (data.contains("tileSize")) {
+        tileWidth = data.at("tileSize").value("width", 16);
+        tileHeight = data.at("tileSize").value("height", 16);
+    }
+    int mapWidth = 224, mapHeight = 240;
+    if (data.contains("levelSize")) {
+        mapWidth = data.at("levelSize").value("width", 224);
+        mapHeight = data.at("levelSize").value("height", 240);
+    }
 
     // ✅ Layered tilemaps
     tileLayers.clear();
-	for (auto it = data["tileLayers"].rbegin(); it != data["tileLayers"].rend(); ++it) {
+	const json& layers = data.contains("tileLayers") ? data.at("tileLayers") : json::array();
+	for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
 		const auto& layer = *it;
 
-		auto tilemap = std::make_unique<TileMap>(shader, tileTex, mapWidth, mapHeight, tileWidth, tileHeight);
+		auto tilemap = std::make_unique<TileMap>(shader, tileTex.texture, mapWidth, mapHeight, tileWidth, tileHeight);
+		tilemap->SetTextureRegion(tileTex.rect);
 		tilemap->SetTextRenderer(sharedText);
 
 		if (layer.contains("tilemap") && layer["tilemap"].is_array()) {
-			tilemap->Load(layer["tilemap"]);
+			tilemap->Load(layer.at("tilemap"));
 		} else {
-			std::cerr << "Layer missing or invalid tilemap\n";
+			LOG_WARN("Layer missing or invalid tilemap");
 			continue;
 		}
 
 		bool isCollidable = layer.value("collidable", false);
 		tilemap->SetCollidable(isCollidable);
-		std::cout << "Loaded layer with collidable = " << isCollidable << "\n";
+		LOG_DEBUG("Loaded layer with collidable = %d", isCollidable);
 
 		tileLayers.push_back(std::move(tilemap));
 	}
 
+    // The map may be larger than the screen
+    mapSize_ = ComputeMapSize(data);
+    camera_.SetBounds(glm::vec2(0.0f), mapSize_);
+
     // ✅ Solid tiles
-    for (int tileID : data["solid"]) {
-        solidTiles.insert(tileID);
+    if (data.contains("solid")) {
+        for (int tileID : data.at("solid")) {
+            if (solidTiles.empty())
+                blockTile_ = tileID;
+            solidTiles.insert(tileID);
+        }
     }
 
+    // ✅ Navigation grid for enemy pathfinding
+    std::vector<const std::vector<std::vector<int>>*> collidableData;
+    for (const auto& layer : tileLayers)
+        if (layer->IsCollidable())
+            collidableData.push_back(&layer->GetMapData());
+    navGrid_.Build(collidableData, solidTiles, tileWidth, tileHeight);
+    pathfinder_.SetGrid(&navGrid_);
+    flowField_.SetGrid(&navGrid_);
+    hierarchicalPathfinder_.Build(&navGrid_);
+
     // ✅ Player
-    const auto& playerData = data["player"];
-    float px = playerData["x"];
-    float py = playerData["y"];
+    const auto& playerData = data.at("player");
+    float px = playerData.at("x");
+    float py = playerData.at("y");
     float pscale = playerData.value("scale", 0.6f);
 	float pcollscale = playerData.value("collisionScale", 1.0f);
-    auto dogTex = ResourceManager::GetTexture("dog");
-    dog_ = std::make_unique<Dog>(shader, dogTex, glm::vec2(px, py), glm::ivec2(1, 0));
+    const TextureRegion& dogTex = GetTextureRegion("dog");
+    int dogAnim = AnimationLibrary::Find("dog");
+    if (dogAnim < 0) {
+        LOG_ERROR("❌ No 'dog' sprite sheet in the animation library");
+        return;
+    }
+    dog_ = std::make_unique<Dog>(shader, dogTex.texture, glm::vec2(px, py), dogAnim);
+    dog_->SetTextureRegion(dogTex.rect);
     dog_->SetScale(pscale);
 	dog_->SetCollisionScale(pcollscale);
+	camera_.SnapTo(dog_->GetBoundingCircle().center);
 
 
     // ✅ Enemies
-    for (const auto& e : data["enemies"]) {
-        std::string type = e["type"];
-        auto shader = ResourceManager::GetShader(e.value("shader", "sprite"));
-        auto texture = ResourceManager::GetTexture(e["texture"]);
-
-        glm::vec2 pos = {e["x"], e["y"]};
-        glm::ivec2 frame = {e["frameX"], e["frameY"]};
-        float fw = e["frameW"];
-        float fh = e["frameH"];
-        int cols = e["frameCount"];
-        int rows = e["animSpeed"];
-        float scale = e.value("scale", 1.0f);
-    	float collscale = e.value("collisionScale", 1.0f);
-
-        auto enemy = EnemyRegistry::Create(type, shader, texture, pos, frame, fw, fh, cols, rows);
-        if (enemy) {
-            enemy->SetScale(scale);
-        	enemy->SetCollisionScale(collscale);
-
-            enemies.push_back(std::move(enemy));
-        } else {
-            std::cerr << "❌ Unknown enemy type: " << type << "\n";
+    EnemyActivityConfig activity;
+    if (data.contains("enemyActivity")) {
+        const auto& a = data.at("enemyActivity");
+        activity.activeRadius = a.value("activeRadius", activity.activeRadius);
+        activity.sleepRadius = a.value("sleepRadius", activity.sleepRadius);
+        activity.reducedInterval = a.value("reducedInterval", activity.reducedInterval);
+        activity.wakeDuration = a.value("wakeDuration", activity.wakeDuration);
+        activity.wakeRadius = a.value("wakeRadius", activity.wakeRadius);
+        activity.viewMargin = a.value("viewMargin", activity.viewMargin);
+    }
+    enemies.SetActivityConfig(activity);
+    const json& enemyData = data.contains("enemies") ? data.at("enemies") : json::array();
+    enemies.Reserve(std::max<std::size_t>(enemyData.size(), MinEnemyCapacity));
+    for (const auto& e : enemyData) {
+        std::string type = e.at("type");
+        int typeId = EnemyRegistry::Find(type);
+        if (typeId < 0) {
+            LOG_ERROR("❌ Unknown enemy type: %s", type.c_str());
+            continue;
         }
+
+        // Anything the entry leaves out comes from the archetype
+        const EnemyArchetype& arch = EnemyRegistry::Archetype(typeId);
+        auto shader = ResourceManager::GetShader(e.value("shader", arch.shader));
+        const TextureRegion& texture = GetTextureRegion(e.value("texture", arch.texture));
+
+        std::string animName = e.value("animation", arch.animation);
+        int animation = AnimationLibrary::Find(animName);
+        if (animation < 0) {
+            LOG_ERROR("❌ Unknown animation sheet: %s", animName.c_str());
+            continue;
+        }
+        std::string clipName = e.value("clip", arch.clip);
+        int clip = AnimationLibrary::Sheet(animation).FindClip(clipName);
+        if (clip < 0) {
+            LOG_ERROR("❌ Unknown clip %s in sheet %s", clipName.c_str(), animName.c_str());
+            continue;
+        }
+
+        glm::vec2 pos = {e.at("x"), e.at("y")};
+        float scale = e.value("scale", arch.scale);
+    	float collscale = e.value("collisionScale", arch.collisionScale);
+
+        std::uint16_t sheet = enemies.AddSheet(shader, texture.texture, animation, texture.rect);
+        // Stream = spawn order, so patrols don't depend on who updates first
+        enemies.Spawn(typeId, sheet, pos, static_cast<std::uint16_t>(clip), scale, collscale, Rng(seed_, enemies.Size()));
     }
 
 	transitions_.clear();
 	if (data.contains("transitions")) {
-		for (const auto& t : data["transitions"]) {
+		for (const auto& t : data.at("transitions")) {
 			LevelTransition lt{};
-			lt.pos       = glm::ivec2(t["x"], t["y"]);
+			lt.pos       = glm::ivec2(t.at("x"), t.at("y"));
 			lt.size      = glm::ivec2(t.value("width", 1), t.value("height", 1));
-			lt.targetLevel = t["targetLevel"];
+			lt.targetLevel = t.at("targetLevel");
 			if (t.contains("spawnX") && t.contains("spawnY")) {
-				lt.spawn = glm::vec2(t["spawnX"], t["spawnY"]);
+				lt.spawn = glm::vec2(t.at("spawnX"), t.at("spawnY"));
 			}
 			transitions_.push_back(lt);
 		}
@@ -183,106 +316,119 @@ int Level::Update(float dt) {
 
     // If there's no valid collidable map data, skip everything and return “no transition”
     if (mapDataPtrs.empty()) {
-        std::cerr << "❌ No valid collidable map data! Skipping update to avoid crash.\n";
+        LOG_ERROR("❌ No valid collidable map data! Skipping update to avoid crash.");
         return -1; // <— MUST return -1 here (meaning “no level change”)
     }
 
-    // 2) Gather tile sizes and screen size
+    // 2) Gather tile sizes
     int tileWidth  = tileLayers[0]->GetTileWidth();
     int tileHeight = tileLayers[0]->GetTileHeight();
-    glm::vec2 screenSize = { internalWidth, internalHeight };
 
     // 3) Update enemies
-    Circle playerCircle = dog_->ComputeBoundingCircle();
-    for (auto& enemy : enemies) {
-        enemy->Update(dt, mapDataPtrs, solidTiles, tileWidth, tileHeight, playerCircle);
-    }
+    Circle playerCircle = dog_->GetBoundingCircle();
+    flowField_.Update(navGrid_.CellAt(playerCircle.center));
+    ViewRect visible = camera_.GetVisibleRect();
+    enemies.Update(dt, mapDataPtrs, solidTiles, tileWidth, tileHeight, playerCircle,
+                   { &pathfinder_, &hierarchicalPathfinder_, &flowField_ }, &visible);
 
     // 4) Update the player (dog)
-    dog_->Update(dt, mapDataPtrs, solidTiles, tileWidth, tileHeight, screenSize);
-    playerCircle = dog_->ComputeBoundingCircle();
+    dog_->Update(dt, mapDataPtrs, solidTiles, tileWidth, tileHeight, mapSize_);
+    playerCircle = dog_->GetBoundingCircle();
 
     // 5) Resolve any player‐enemy overlap
-    for (auto& enemy : enemies) {
-        Circle enemyCircle = enemy->ComputeBoundingCircle();
+    for (std::size_t i = 0; i < enemies.Size(); ++i) {
+        Circle enemyCircle = enemies.ComputeBoundingCircle(i);
         if (!CircleIntersect(playerCircle, enemyCircle)) continue;
 
-        std::cout << "💥 Player collided with enemy!\n";
+        LOG_TRACE("💥 Player collided with enemy!");
         glm::vec2 pushDir = glm::normalize(playerCircle.center - enemyCircle.center);
         glm::vec2 newCenter = playerCircle.center + pushDir * 2.0f;
         Circle pushed = playerCircle;
         pushed.center = newCenter;
 
         if (!IsCircleBlocked(pushed, mapDataPtrs, tileWidth, tileHeight, solidTiles)) {
-            // Compute how far to move the dog’s sprite (half‐width/height of the sprite)
-            float halfW = ((256.0f / 16.0f) * 0.5f) * dog_->GetScale();
-            float halfH = ((48.0f / 3.0f) * 0.5f) * dog_->GetScale();
-            dog_->SetPosition(pushed.center - glm::vec2(halfW, halfH));
+            // Sprite position is the top-left corner, half a sprite from the centre
+            dog_->SetPosition(pushed.center - dog_->GetSize() * 0.5f);
         } else {
             dog_->SetVelocity({0.0f, 0.0f});
         }
     }
 
+    // 5b) Camera follows the dog's settled position
+    glm::vec2 playerCenter = dog_->GetBoundingCircle().center;
+    camera_.Follow(playerCenter, dt);
+
     // 6) Check for level transition (tile‐space)
-    glm::vec2 playerCenter = dog_->ComputeBoundingCircle().center;
     int tileX = static_cast<int>(playerCenter.x) / tileWidth;
     int tileY = static_cast<int>(playerCenter.y) / tileHeight;
 
+    const LevelTransition* entered = nullptr;
+    for (const auto& t : transitions_) {
+        bool insideX = (tileX >= t.pos.x && tileX <  t.pos.x + t.size.x);
+        bool insideY = (tileY >= t.pos.y && tileY <  t.pos.y + t.size.y);
+        if (insideX && insideY && t.targetLevel != currentLevel_) {
+            entered = &t;
+            break;
+        }
+    }
+    if (holdTransitions_) {
+        holdTransitions_ = entered != nullptr;
+        entered = nullptr;
+    }
+
     if (transitionCooldown_ > 0.0f) {
         transitionCooldown_ -= dt;
-    } else {
-        for (const auto& t : transitions_) {
-            bool insideX = (tileX >= t.pos.x && tileX <  t.pos.x + t.size.x);
-            bool insideY = (tileY >= t.pos.y && tileY <  t.pos.y + t.size.y);
-
-            if (insideX && insideY && t.targetLevel != currentLevel_) {
-                std::cout << "[Level::Update] 🔁 Transition to level "
-                          << t.targetLevel << "\n";
-                lastLevel_ = currentLevel_;
-
-                // If there is a spawn override, convert it from tile→pixel now
-                glm::vec2 spawnOverride = dog_->GetPosition();
-                bool hasSpawn = false;
-                if (t.spawn.has_value()) {
-                    spawnOverride = glm::vec2(
-                        t.spawn->x * tileWidth,
-                        t.spawn->y * tileHeight
-                    );
-                    hasSpawn = true;
-                }
-
-                transitionCooldown_ = 1.0f; // one‐second cooldown to avoid immediate retrigger
-
-                // Return the index of the next level; LevelManager will actually load it
-                return t.targetLevel;
-            }
+    } else if (entered) {
+        const LevelTransition& t = *entered;
+        LOG_INFO("[Level::Update] 🔁 Transition to level %d", t.targetLevel);
+        lastLevel_ = currentLevel_;
+
+        // If there is a spawn override, convert it from tile→pixel now
+        glm::vec2 spawnOverride = dog_->GetPosition();
+        bool hasSpawn = false;
+        if (t.spawn.has_value()) {
+            spawnOverride = glm::vec2(
+                t.spawn->x * tileWidth,
+                t.spawn->y * tileHeight
+            );
+            hasSpawn = true;
         }
+
+        transitionCooldown_ = 1.0f; // one‐second cooldown to avoid immediate retrigger
+
+        // Return the index of the next level; LevelManager will actually load it
+        return t.targetLevel;
     }
 	// ─── Bite‐attack collision check ───
 	if (dog_->IsBitingActive()) {
 		// Compute the small bite circle in front of the dog
 		Circle biteCircle = dog_->ComputeBiteCircle();
 
+		// The noise wakes anything dozing nearby
+		enemies.WakeNear(biteCircle.center, enemies.GetActivityConfig().wakeRadius);
+
 		// Loop over enemies, check for intersection with the bite circle
 		// We’ll remove any enemy that is intersecting.
 		bool anyEnemyRemoved = false;
-		for (auto it = enemies.begin(); it != enemies.end(); /*no increment here*/) {
-			Circle enemyCircle = (*it)->ComputeBoundingCircle();
+		for (std::size_t i = 0; i < enemies.Size(); /*no increment here*/) {
+			Circle enemyCircle = enemies.ComputeBoundingCircle(i);
 			if (CircleIntersect(biteCircle, enemyCircle)) {
-				std::cout << "[Level] Enemy hit by bite!\n";
-				// If your Enemy has a TakeDamage() or OnHit() method, call it here.
-				// For now we just remove the enemy from the vector:
+				LOG_DEBUG("[Level] Enemy hit by bite!");
+				// Damage/OnHit would go here. For now we just remove the enemy:
 
-				it = enemies.erase(it);
+				enemies.RemoveAt(i);   // swaps the last enemy into i
 				anyEnemyRemoved = true;
 			}
 			else {
-				++it;
+				++i;
 			}
 		}
 		// you can optionally do something if anyEnemyRemoved == true
 	}
 
+	Stats::Set(StatCounter::Enemies, enemies.Size());
+	Stats::Set(StatCounter::EnemiesAwake, enemies.GetAwakeCount());
+
 	// 7) No transition triggered: return -1
 	return -1;
 }
@@ -291,73 +437,178 @@ int Level::Update(float dt) {
 
 
 
+const TextureRegion& Level::GetTextureRegion(const std::string& name) const {
+    static const TextureRegion missing;
+    auto it = textures_.find(name);
+    if (it != textures_.end()) return it->second;
+    LOG_ERROR("❌ Texture '%s' is not in this level's resources", name.c_str());
+    return missing;
+}
+
+std::size_t Level::EstimateMemoryUsage() const {
+    std::size_t bytes = enemies.GetMemoryUsage();
+    bytes += static_cast<std::size_t>(navGrid_.GetCellCount()) * BytesPerNavCell;
+    for (const auto& layer : tileLayers) {
+        const auto& rows = layer->GetMapData();
+        if (!rows.empty())
+            bytes += rows.size() * rows[0].size() * sizeof(int);
+    }
+    return bytes;
+}
+
+std::size_t Level::EstimateMemoryUsage(const json& data) {
+    std::size_t enemyCount = data.contains("enemies") ? data["enemies"].size() : 0;
+    std::size_t bytes = EnemyStore::EstimateMemoryUsage(std::max(enemyCount, MinEnemyCapacity));
+    std::size_t navCells = 0;
+    if (data.contains("tileLayers")) {
+        for (const auto& layer : data["tileLayers"]) {
+            if (!layer.contains("tilemap") || !layer["tilemap"].is_array() || layer["tilemap"].empty()) continue;
+            const auto& rows = layer["tilemap"];
+            std::size_t cells = rows.size() * rows[0].size();
+            bytes += cells * sizeof(int);
+            if (layer.value("collidable", false))
+                navCells = std::max(navCells, cells);
+        }
+    }
+    return bytes + navCells * BytesPerNavCell;
+}
+
+void Level::SetTileBlocked(int x, int y, bool blocked) {
+	if (!navGrid_.InBounds(x, y) || navGrid_.IsBlocked(x, y) == blocked) return;
+
+	auto covers = [x, y](const TileMap& layer) {
+		const auto& map = layer.GetMapData();
+		return y < static_cast<int>(map.size()) && x < static_cast<int>(map[y].size());
+	};
+
+	// The collidable layers are what the dog and enemies collide with.
+	// Toggling a cell back restores the tiles the first edit replaced.
+	auto isCell = [x, y](const TileEdit& e) { return e.x == x && e.y == y; };
+	bool changed = false;
+	if (std::any_of(tileEdits_.begin(), tileEdits_.end(), isCell)) {
+		for (const TileEdit& e : tileEdits_)
+			if (isCell(e))
+				tileLayers[e.layer]->SetTile(x, y, e.tileID);
+		std::erase_if(tileEdits_, isCell);
+		changed = true;
+	} else if (blocked) {
+		if (blockTile_ < 0) {
+			LOG_WARN("⚠️ Level has no solid tiles, can't block (%d, %d)", x, y);
+			return;
+		}
+		for (std::size_t i = 0; i < tileLayers.size() && !changed; ++i) {
+			TileMap& layer = *tileLayers[i];
+			if (!layer.IsCollidable() || !covers(layer)) continue;
+			tileEdits_.push_back({ x, y, i, layer.GetMapData()[y][x] });
+			layer.SetTile(x, y, blockTile_);
+			changed = true;
+		}
+	} else {
+		for (std::size_t i = 0; i < tileLayers.size(); ++i) {
+			TileMap& layer = *tileLayers[i];
+			if (!layer.IsCollidable() || !covers(layer) || !solidTiles.count(layer.GetMapData()[y][x])) continue;
+			tileEdits_.push_back({ x, y, i, layer.GetMapData()[y][x] });
+			layer.SetTile(x, y, -1);
+			changed = true;
+		}
+	}
+	if (!changed) {
+		LOG_WARN("⚠️ No collidable layer covers (%d, %d); tile left as it is", x, y);
+		return;
+	}
+
+	navGrid_.SetBlocked(x, y, blocked);
+	hierarchicalPathfinder_.OnTileChanged(x, y);
+	pathfinder_.ClearCache();
+	if (flowField_.IsValid())
+		flowField_.Update(flowField_.GetGoal(), true);
+}
+
 void Level::Render(const glm::mat4& proj) {
-	for (auto& layer : tileLayers)
-		layer->Draw(proj);
+	// Only what the camera sees is drawn
+	RenderView(proj, camera_.GetVisibleRect(), true);
+}
 
-	for (auto& enemy : enemies)
-		enemy->Draw(proj);
+void Level::RenderView(const glm::mat4& proj, const ViewRect& visible, bool drawPlayer) {
+	FrameUniforms::SetViewProjection(proj);
+	SubmitView(renderQueue_, visible, drawPlayer);
+	renderQueue_.Execute();
 
-	dog_->Draw(proj);
+	if (!drawPlayer || !dog_) return;
 
 	if (debugMode_ && debugShader_) {
 		// 🔴 Debug player + enemy circles
-		DrawDebugCircle(dog_->ComputeBoundingCircle(), glm::vec3(1.0f, 0.0f, 0.0f), proj, debugShader_);
-		for (auto& enemy : enemies)
-			DrawDebugCircle(enemy->ComputeBoundingCircle(), glm::vec3(0.0f, 1.0f, 0.0f), proj, debugShader_);
-
-		// 🟩 Draw debug grid from the layer with most rows
-		if (!tileLayers.empty()) {
-			TileMap* bestLayer = tileLayers[0].get();
-			size_t maxRows = bestLayer->GetMapData().size();
-			size_t maxCols = maxRows > 0 ? bestLayer->GetMapData()[0].size() : 0;
-
-			for (const auto& layer : tileLayers) {
-				const auto& data = layer->GetMapData();
-				size_t rows = data.size();
-				size_t cols = rows > 0 ? data[0].size() : 0;
-				if ((rows > maxRows) || (rows == maxRows && cols > maxCols)) {
-					bestLayer = layer.get();
-					maxRows = rows;
-					maxCols = cols;
-				}
-			}
+		DrawDebugCircle(dog_->GetBoundingCircle(), glm::vec3(1.0f, 0.0f, 0.0f), debugShader_);
+		for (std::size_t i = 0; i < enemies.Size(); ++i)
+			DrawDebugCircle(enemies.ComputeBoundingCircle(i), glm::vec3(0.0f, 1.0f, 0.0f), debugShader_);
+		CaptureDebugGrid(debugGrid_);
+		DrawDebugGrid(debugGrid_);
+	}
+}
+
+void Level::Snapshot(RenderSnapshot& out, const glm::mat4& proj, const ViewRect& visible, bool drawPlayer) {
+	SubmitView(out.AddView(proj), visible, drawPlayer);
+
+	if (!drawPlayer || !dog_ || !debugMode_ || !debugShader_) return;
+	out.AddDebugCircle(dog_->GetBoundingCircle(), glm::vec3(1.0f, 0.0f, 0.0f));
+	for (std::size_t i = 0; i < enemies.Size(); ++i)
+		out.AddDebugCircle(enemies.ComputeBoundingCircle(i), glm::vec3(0.0f, 1.0f, 0.0f));
+	out.SetDebug(this, debugShader_, proj);
+	CaptureDebugGrid(out.GetDebugGrid());
+}
+
+void Level::SubmitView(RenderQueue& queue, const ViewRect& visible, bool drawPlayer) const {
+	// Tile layers in file order, then enemies, then the player
+	std::uint8_t layer = 0;
+	for (auto& tiles : tileLayers)
+		tiles->Submit(queue, layer++, &visible);
+	enemies.Submit(queue, layer++, &visible);
+	if (drawPlayer && dog_)
+		dog_->Submit(queue, layer);
+}
 
-			bestLayer->DrawDebugGrid(proj, debugShader_, solidTiles, tileLayers);
+void Level::CaptureDebugGrid(DebugTileGrid& grid) const {
+	grid = {};
+	if (tileLayers.empty()) return;
+
+	// 🟩 Draw debug grid from the layer with most rows
+	const TileMap* bestLayer = tileLayers[0].get();
+	size_t maxRows = bestLayer->GetMapData().size();
+	size_t maxCols = maxRows > 0 ? bestLayer->GetMapData()[0].size() : 0;
+
+	for (const auto& layer : tileLayers) {
+		const auto& data = layer->GetMapData();
+		size_t rows = data.size();
+		size_t cols = rows > 0 ? data[0].size() : 0;
+		if ((rows > maxRows) || (rows == maxRows && cols > maxCols)) {
+			bestLayer = layer.get();
+			maxRows = rows;
+			maxCols = cols;
 		}
 	}
+
+	bestLayer->CaptureDebugGrid(grid, solidTiles, tileLayers);
+}
+
+void Level::DrawDebugGrid(const DebugTileGrid& grid) {
+	if (tileLayers.empty() || !debugShader_) return;
+	tileLayers[0]->DrawDebugGrid(debugShader_, grid);
 }
 
 
-void Level::ProcessInput(float dt, const bool* keys) {
+void Level::ProcessInput(float dt, const ActionState& input) {
 	glm::vec2 velocity(0.0f);
-	if (keys[GLFW_KEY_W]) velocity.y -= 1.0f;
-	if (keys[GLFW_KEY_S]) velocity.y += 1.0f;
-	if (keys[GLFW_KEY_A]) velocity.x -= 1.0f;
-	if (keys[GLFW_KEY_D]) velocity.x += 1.0f;
-
-	// Trigger bite on SPACE (only when not paused, etc.)
-	static bool spacePressed = false;
-	if (keys[GLFW_KEY_SPACE]) {
-		if (!spacePressed) {
-			spacePressed = true;
-			if (dog_) {
-				dog_->StartBite();
-			}
-		}
-	} else {
-		spacePressed = false;
-	}
+	if (input.IsHeld(InputAction::MoveUp)) velocity.y -= 1.0f;
+	if (input.IsHeld(InputAction::MoveDown)) velocity.y += 1.0f;
+	if (input.IsHeld(InputAction::MoveLeft)) velocity.x -= 1.0f;
+	if (input.IsHeld(InputAction::MoveRight)) velocity.x += 1.0f;
 
-static bool tabPressed = false;
-	if (keys[GLFW_KEY_TAB]) {
-		if (!tabPressed) {
-			debugMode_ = !debugMode_;
-			tabPressed = true;
-		}
-	} else {
-		tabPressed = false;
-	}
+	// Edges come from the events, so a tap released within the tick still bites
+	if (input.WasPressed(InputAction::Bite) && dog_)
+		dog_->StartBite();
+
+	if (input.WasPressed(InputAction::ToggleDebug))
+		debugMode_ = !debugMode_;
 
 
 	if (glm::length(velocity) > 0.0f)
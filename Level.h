@@ -1,36 +1,121 @@
 // Level.h
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <unordered_set>
 
+#include <nlohmann/json_fwd.hpp>
+
+#include "Camera.h"
 #include "Dog.h"
+#include "RenderQueue.h"
+#include "RESOURCE_MANAGER.h"
 #include "TileMap.h"
-#include "Enemy.h"
+#include "EnemyStore.h"
+#include "NavGrid.h"
+#include "Pathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "FlowField.h"
+#include "Input.h"
+
+class RenderSnapshot;
 
 class Level {
 public:
 	Level();
 	~Level();
 
-void Load(int index, unsigned int width, unsigned int height);
+void Load(int index, unsigned int width, unsigned int height, std::uint64_t seed = 0);
                 // Load tilemap, enemies, etc.
+	// Same, from already parsed level data (GL thread only). Data missing
+	// the player or with mistyped fields leaves the level unloaded and
+	// returns false; missing optional blocks are skipped.
+	bool Load(const nlohmann::json& data, int index, unsigned int width, unsigned int height, std::uint64_t seed = 0);
+	// Reads and parses resources/levels/level<index>.json without touching GL,
+	// so it may run on any thread; a discarded value on failure
+	static nlohmann::json ReadData(int index);
+	// World-pixel extent of a level: its largest tile layer, at least one screen
+	static glm::vec2 ComputeMapSize(const nlohmann::json& data);
+	// Load's body; throws nlohmann::json::exception on bad data
+	void LoadData(const nlohmann::json& data, int index, unsigned int width, unsigned int height, std::uint64_t seed);
 	void Unload();                          // Free level-specific memory
 	int Update(float dt);                 // Update all enemies
 	void Render(const glm::mat4& proj);    // Draw tilemap + enemies
-	void ProcessInput(float dt, const bool* keys);
-	const glm::mat4& GetProjection() const { return projection_; }
+	// Draws what overlaps visible (level-local coordinates); streamed
+	// neighbour chunks are drawn this way without their player. proj becomes
+	// the frame's view-projection for these draws.
+	void RenderView(const glm::mat4& proj, const ViewRect& visible, bool drawPlayer);
+	// Same as RenderView, but into a snapshot drawn later (any thread)
+	void Snapshot(RenderSnapshot& out, const glm::mat4& proj, const ViewRect& visible, bool drawPlayer);
+	// Grid of the layer with the most cells, copied out so it can be drawn
+	// while the simulation runs on
+	void CaptureDebugGrid(DebugTileGrid& grid) const;
+	// Draws a captured grid through the current view-projection; reads no tile data
+	void DrawDebugGrid(const DebugTileGrid& grid);
+	void ProcessInput(float dt, const ActionState& input);
+	// Camera view of the level; set up at load and follows the dog every update
+	const glm::mat4& GetViewProjection() const { return camera_.GetViewProjection(); }
+	Camera& GetCamera() { return camera_; }
+	glm::vec2 GetMapSize() const { return mapSize_; }
+	glm::ivec2 GetTileSize() const {
+		return tileLayers.empty() ? glm::ivec2(16) : glm::ivec2(tileLayers[0]->GetTileWidth(), tileLayers[0]->GetTileHeight());
+	}
+	// Transitions stay off until the dog stands on none of them, so a dog
+	// handed over onto a transition tile doesn't bounce straight on
+	void HoldTransitionsUntilClear() { holdTransitions_ = true; }
+
+	// World streaming hands the dog from one loaded level to the next
+	std::unique_ptr<Dog> ReleaseDog() { return std::move(dog_); }
+	void AdoptDog(std::unique_ptr<Dog> dog) { dog_ = std::move(dog); }
+
+	// Rough CPU-side footprint (tiles, navigation, enemies) for streaming
+	// budgets; textures are shared between levels and not counted
+	std::size_t EstimateMemoryUsage() const;
+	// The same estimate from parsed level data, before building it
+	static std::size_t EstimateMemoryUsage(const nlohmann::json& data);
 	float GetInternalWidth() const { return internalWidth; }
 	float GetInternalHeight() const { return internalHeight; }
 
 
 	std::unique_ptr<TileMap> tileMap;
-	std::vector<std::unique_ptr<Enemy>> enemies;
+	EnemyStore enemies;
+	// Enemy arrays are sized for at least this many at load, so spawns stay off the heap
+	static constexpr std::size_t MinEnemyCapacity = 256;
+	// Grid, flow field and search buffers together, per navigation cell
+	static constexpr std::size_t BytesPerNavCell = 24;
+	NavGrid navGrid_;          // walkability of the collidable layers, built at load
+	Pathfinder pathfinder_;
+	FlowField flowField_;      // towards the dog, rebuilt when it changes tile
+	HierarchicalPathfinder hierarchicalPathfinder_;
+
+	// Runtime tile edits (doors, destructible walls). Blocking puts the
+	// level's first solid tile on the first collidable layer covering the
+	// cell, unblocking empties the cell's solid tiles on every collidable
+	// layer; the replaced tiles come back when the edit is undone. Collision,
+	// drawing and every navigation structure follow the change.
+	void SetTileBlocked(int x, int y, bool blocked);
 	std::unordered_set<int> solidTiles;
+	int blockTile_ = -1;   // first entry of "solid", what SetTileBlocked places
+	// Tiles SetTileBlocked replaced, to restore when a cell is toggled back
+	struct TileEdit {
+		int x, y;
+		std::size_t layer;
+		int tileID;
+	};
+	std::vector<TileEdit> tileEdits_;
 	std::unique_ptr<Dog> dog_;
+	// Sprites of a RenderView, sorted and drawn in one pass; kept to reuse its storage
+	RenderQueue renderQueue_;
+	DebugTileGrid debugGrid_;   // RenderView's capture, kept to reuse its storage
+	void SubmitView(RenderQueue& queue, const ViewRect& visible, bool drawPlayer) const;
 	float internalWidth = 496.0f;
 	float internalHeight = 272.0f;
-	std::unordered_set<std::string> loadedTextureNames;
+	// This level's textures by resource name, as regions of shared atlas
+	// pages; textureFiles_ is what to release on unload
+	std::unordered_map<std::string, TextureRegion> textures_;
+	std::vector<std::string> textureFiles_;
+	const TextureRegion& GetTextureRegion(const std::string& name) const;
 	std::unordered_set<std::string> loadedShaderNames;
 	std::vector<std::unique_ptr<TileMap>> tileLayers;
 	std::shared_ptr<Shader> debugShader_;
@@ -43,13 +128,17 @@ void Load(int index, unsigned int width, unsigned int height);
 	};
 
 	int lastLevel_ = -1;
+	std::uint64_t seed_ = 0;   // per-level seed; enemy i uses stream i
 	int currentLevel_ = -1;
 	float transitionCooldown_ = 0.0f;
+	bool holdTransitions_ = false;
 
 	std::vector<LevelTransition> transitions_;
+	const std::vector<LevelTransition>& GetTransitions() const { return transitions_; }
 
 
 
-	glm::mat4 projection_;
+	Camera camera_;
+	glm::vec2 mapSize_{ 0.0f };   // world pixels; the dog and camera stay inside
 
 };
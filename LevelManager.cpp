@@ -1,40 +1,93 @@
 // LevelManager.cpp
 #include "LevelManager.h"
 
-#include <iostream>
+#include <chrono>
+
+#include "FramePipeline.h"
+#include "Log.h"
+#include "Random.h"
+#include "Stats.h"
 
 void LevelManager::LoadLevel(int index, unsigned int width, unsigned int height) {
 	lastWindowWidth  = width;
 	lastWindowHeight = height;
+	auto start = std::chrono::steady_clock::now();
 	UnloadLevel();
+	// Neighbours go too: a reload starts a new world rooted at this level
+	streamer_.Reset(index);
 	level = std::make_unique<Level>();
-	level->Load(index, width, height);
+	level->Load(index, width, height, Random::Combine(seed_, static_cast<std::uint64_t>(index)));
 	currentLevelIndex = index;
+	pendingLevel_ = -1;
+	++revision_;
+
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	Stats::RecordLevelLoad(index, elapsed.count());
 }
 
 
 void LevelManager::Update(float dt) {
-	if (!level) return;
+	if (!level || HasPendingGLWork()) return;
 
 	// 1) Call Level::Update() and see if it returned a new level index
 	int nextLevel = level->Update(dt);
 
-	// 2) If nextLevel >= 0, it means “transition triggered” → load that level
+	// 2) If nextLevel >= 0, it means “transition triggered” → walk into it
+	//    if it is a streamed neighbour, otherwise load that level. Off the
+	//    GL thread that waits for RunGLWork, which finishes the tick.
 	if (nextLevel >= 0) {
-		std::cout << "[LevelManager] Loading level " << nextLevel << "\n";
-		LoadLevel(nextLevel, lastWindowWidth , lastWindowHeight);
+		if (deferGLWork_) {
+			pendingLevel_ = nextLevel;
+			return;
+		}
+		EnterLevel(nextLevel);
+	}
+
+	// 3) Pick the neighbours to stream in and out around the camera
+	streamer_.Tick(*level);
+}
+
+void LevelManager::RunGLWork() {
+	if (!level) return;
+	if (pendingLevel_ >= 0) {
+		int nextLevel = pendingLevel_;
+		pendingLevel_ = -1;
+		EnterLevel(nextLevel);
+		streamer_.Tick(*level);
+	}
+	// Build and free what the ticks chose, once per frame
+	streamer_.Update(*level, seed_, lastWindowWidth, lastWindowHeight);
+}
+
+void LevelManager::EnterLevel(int index) {
+	if (streamer_.HandOver(level, index, seed_, lastWindowWidth, lastWindowHeight)) {
+		currentLevelIndex = index;
+	} else {
+		LOG_INFO("[LevelManager] Loading level %d", index);
+		LoadLevel(index, lastWindowWidth , lastWindowHeight);
 	}
 }
 
 void LevelManager::Render(const glm::mat4& proj) {
-	if (level) level->Render(proj);
+	if (!level) return;
+	streamer_.Render(proj, level->GetCamera().GetVisibleRect());
+	level->Render(proj);
+}
+
+void LevelManager::Snapshot(RenderSnapshot& out) {
+	out.Reset(GetRevision());
+	if (!level) return;
+	const glm::mat4& proj = level->GetViewProjection();
+	const ViewRect& visible = level->GetCamera().GetVisibleRect();
+	streamer_.Snapshot(out, proj, visible);
+	level->Snapshot(out, proj, visible, true);
 }
 
 void LevelManager::UnloadLevel() {
 	if (level) level->Unload();
 	level.reset();
 }
-void LevelManager::ProcessInput(float dt, const bool* keys) {
+void LevelManager::ProcessInput(float dt, const ActionState& input) {
 	if (level)
-		level->ProcessInput(dt, keys);
+		level->ProcessInput(dt, input);
 }
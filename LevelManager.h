@@ -1,22 +1,50 @@
 // LevelManager.h
 #pragma once
+#include <cstdint>
 #include <memory>
 #include "Level.h"
+#include "WorldStreamer.h"
 
 class LevelManager {
 public:
 void LoadLevel(int index, unsigned int width, unsigned int height);
 	void Update(float dt);
 	void Render(const glm::mat4& proj);
+	// The active level and the visible neighbours, into a snapshot
+	void Snapshot(RenderSnapshot& out);
 	void UnloadLevel();
 
 	Level* GetCurrentLevel() { return level.get(); }
-	void ProcessInput(float dt, const bool* keys);
+	const Level* GetCurrentLevel() const { return level.get(); }
+	void ProcessInput(float dt, const ActionState& input);
+	// Game seed; each level's seed is derived from it and the level index
+	void SetSeed(std::uint64_t seed) { seed_ = seed; }
+	// Optional seamless streaming between edge-linked levels
+	bool LoadWorldConfig(const std::string& path) { return streamer_.LoadConfig(path); }
+	const WorldStreamer& GetStreamer() const { return streamer_; }
+
+	// With a pipelined frame Update runs off the GL thread, so it must not
+	// load levels. A level transition then stops the updates
+	// (HasPendingGLWork) until the GL thread calls RunGLWork. RunGLWork
+	// also builds the streamed levels; call it once per frame either way.
+	void SetDeferGLWork(bool defer) { deferGLWork_ = defer; }
+	bool HasPendingGLWork() const { return pendingLevel_ >= 0; }
+	void RunGLWork();
+	// Changes whenever the set of live levels does; snapshots from an older
+	// revision may point at freed textures
+	std::uint64_t GetRevision() const { return revision_ + streamer_.GetRevision(); }
 
 
 private:
+	void EnterLevel(int index);
+
 	std::unique_ptr<Level> level;
+	WorldStreamer streamer_;
 	int currentLevelIndex = -1;
+	std::uint64_t seed_ = 0;
 	unsigned int lastWindowWidth  = 0;
 	unsigned int lastWindowHeight = 0;
+	bool deferGLWork_ = false;
+	int pendingLevel_ = -1;
+	std::uint64_t revision_ = 0;
 };
@@ -0,0 +1,193 @@
+// Log.cpp
+#include "Log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+    constexpr std::size_t RingCapacity = 1024;   // records per thread, power of two
+    constexpr std::size_t MaxThreads = 32;
+
+    struct LogRecord {
+        std::int64_t timeUs;
+        LogLevel level;
+        std::uint16_t length;
+        char text[Log::MaxMessageLength];
+    };
+
+    // Single-producer (owning thread) / single-consumer (flush thread) ring
+    struct LogRing {
+        std::array<LogRecord, RingCapacity> records;
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::size_t threadIndex = 0;
+    };
+
+    // Rings are registered once per thread and live until exit, so the
+    // flush thread can read them without any locking.
+    std::array<std::unique_ptr<LogRing>, MaxThreads> ringStorage;
+    std::array<std::atomic<LogRing*>, MaxThreads> rings{};
+    std::atomic<std::size_t> ringCount{0};
+
+    std::atomic<bool> running{false};
+    std::thread flushThread;
+    std::FILE* output = nullptr;
+    bool ownsOutput = false;
+    const auto epoch = std::chrono::steady_clock::now();
+
+    const char* levelNames[] = { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+    std::int64_t NowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    // One-time allocation the first time a thread logs (or registers);
+    // nullptr once the thread table is exhausted (those threads log
+    // synchronously).
+    LogRing* ThreadRing() {
+        thread_local LogRing* ring = nullptr;
+        thread_local bool registered = false;
+        if (!registered) {
+            registered = true;
+            std::size_t index = ringCount.fetch_add(1, std::memory_order_relaxed);
+            if (index < MaxThreads) {
+                ringStorage[index] = std::make_unique<LogRing>();
+                ring = ringStorage[index].get();
+                ring->threadIndex = index;
+                rings[index].store(ring, std::memory_order_release);
+            }
+        }
+        return ring;
+    }
+
+    void WriteLine(std::FILE* out, std::int64_t timeUs, LogLevel level, std::size_t thread, const char* text, std::size_t length) {
+        char prefix[48];
+        int n = std::snprintf(prefix, sizeof(prefix), "[%10.3f] [%s] [%zu] ",
+                              static_cast<double>(timeUs) / 1.0e6, levelNames[static_cast<int>(level)], thread);
+        std::fwrite(prefix, 1, static_cast<std::size_t>(n), out);
+        std::fwrite(text, 1, length, out);
+        std::fputc('\n', out);
+    }
+
+    // Returns true if anything was written
+    bool DrainRings() {
+        bool wrote = false;
+        std::size_t count = std::min(ringCount.load(std::memory_order_acquire), MaxThreads);
+        for (std::size_t i = 0; i < count; ++i) {
+            LogRing* ring = rings[i].load(std::memory_order_acquire);
+            if (!ring) continue;
+
+            std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+            std::size_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                const LogRecord& r = ring->records[tail & (RingCapacity - 1)];
+                WriteLine(output, r.timeUs, r.level, ring->threadIndex, r.text, r.length);
+                wrote = true;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+
+            if (std::uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed)) {
+                char text[64];
+                int n = std::snprintf(text, sizeof(text), "%llu log messages dropped (ring full)",
+                                      static_cast<unsigned long long>(dropped));
+                WriteLine(output, NowUs(), LogLevel::Warn, ring->threadIndex, text, static_cast<std::size_t>(n));
+                wrote = true;
+            }
+        }
+        if (wrote) std::fflush(output);
+        return wrote;
+    }
+
+    void FlushLoop() {
+        while (running.load(std::memory_order_acquire)) {
+            if (!DrainRings())
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        DrainRings();
+    }
+}
+
+bool Log::Init(const char* path) {
+    if (running.load()) return true;
+
+    bool ok = true;
+    if (path) {
+        output = std::fopen(path, "w");
+        if (!output) {
+            std::fprintf(stderr, "❌ Failed to open log file: %s\n", path);
+            output = stdout;
+            ownsOutput = false;
+            ok = false;
+        } else {
+            ownsOutput = true;
+        }
+    } else {
+        output = stdout;
+        ownsOutput = false;
+    }
+
+    RegisterThread();
+    running.store(true, std::memory_order_release);
+    flushThread = std::thread(FlushLoop);
+    return ok;
+}
+
+void Log::RegisterThread() {
+    ThreadRing();
+}
+
+void Log::Shutdown() {
+    if (!running.exchange(false)) return;
+    if (flushThread.joinable())
+        flushThread.join();
+
+    if (ownsOutput && output)
+        std::fclose(output);
+    output = nullptr;
+    ownsOutput = false;
+}
+
+void Log::Write(LogLevel level, const char* fmt, ...) {
+    LogRing* ring = ThreadRing();
+
+    if (!ring || !running.load(std::memory_order_acquire)) {
+        // No flush thread: write synchronously
+        char text[MaxMessageLength];
+        va_list args;
+        va_start(args, fmt);
+        int n = std::vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+        if (n < 0) return;
+        std::size_t length = std::min(static_cast<std::size_t>(n), sizeof(text) - 1);
+        WriteLine(stderr, NowUs(), level, ring ? ring->threadIndex : MaxThreads, text, length);
+        return;
+    }
+
+    std::size_t head = ring->head.load(std::memory_order_relaxed);
+    std::size_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail >= RingCapacity) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LogRecord& record = ring->records[head & (RingCapacity - 1)];
+    record.timeUs = NowUs();
+    record.level = level;
+
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(record.text, sizeof(record.text), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    record.length = static_cast<std::uint16_t>(std::min(static_cast<std::size_t>(n), sizeof(record.text) - 1));
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
@@ -0,0 +1,63 @@
+// Log.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+enum class LogLevel : std::uint8_t {
+	Trace,
+	Debug,
+	Info,
+	Warn,
+	Error,
+	Off
+};
+
+// Compile-time floor: LOG_* calls below this level compile to nothing,
+// arguments included. 0 = Trace ... 5 = Off.
+#ifndef CATCHASE_LOG_LEVEL
+#define CATCHASE_LOG_LEVEL 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CATCHASE_PRINTF_FORMAT(fmtIndex, argIndex) __attribute__((format(printf, fmtIndex, argIndex)))
+#else
+#define CATCHASE_PRINTF_FORMAT(fmtIndex, argIndex)
+#endif
+
+// Asynchronous logger. Write() formats straight into a preallocated ring
+// owned by the calling thread and returns; a background thread drains every
+// ring to the console or a file. A full ring drops the message (and counts
+// it) rather than blocking the frame. Before Init()/after Shutdown() writes
+// go synchronously to stderr.
+class Log {
+public:
+	static constexpr std::size_t MaxMessageLength = 240;
+
+	// Starts the flush thread. path == nullptr logs to stdout.
+	static bool Init(const char* path = nullptr);
+	// Drains everything still queued and stops the flush thread.
+	static void Shutdown();
+	// Gives the calling thread its ring now. A thread's ring is allocated
+	// the first time it logs, so threads that log on the frame path (job
+	// workers, the pipeline's simulation thread) call this when they start.
+	// Init registers the calling thread.
+	static void RegisterThread();
+
+	static void Write(LogLevel level, const char* fmt, ...) CATCHASE_PRINTF_FORMAT(2, 3);
+
+private:
+	Log() { }
+};
+
+#define CATCHASE_LOG(level, ...) \
+	do { \
+		if constexpr (static_cast<int>(level) >= CATCHASE_LOG_LEVEL) \
+			Log::Write(level, __VA_ARGS__); \
+	} while (0)
+
+#define LOG_TRACE(...) CATCHASE_LOG(LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) CATCHASE_LOG(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  CATCHASE_LOG(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  CATCHASE_LOG(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) CATCHASE_LOG(LogLevel::Error, __VA_ARGS__)
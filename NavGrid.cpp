@@ -0,0 +1,34 @@
+// NavGrid.cpp
+#include "NavGrid.h"
+
+#include <algorithm>
+
+void NavGrid::Build(const std::vector<const std::vector<std::vector<int>>*>& layers,
+                    const std::unordered_set<int>& solidTiles,
+                    int tileWidth, int tileHeight) {
+    tileWidth_ = tileWidth;
+    tileHeight_ = tileHeight;
+
+    width_ = height_ = 0;
+    for (const auto* layer : layers) {
+        if (!layer || layer->empty()) continue;
+        height_ = std::max(height_, static_cast<int>(layer->size()));
+        width_ = std::max(width_, static_cast<int>((*layer)[0].size()));
+    }
+
+    blocked_.assign(static_cast<std::size_t>(width_) * height_, 0);
+    for (const auto* layer : layers) {
+        if (!layer) continue;
+        for (int y = 0; y < static_cast<int>(layer->size()); ++y) {
+            const auto& row = (*layer)[y];
+            for (int x = 0; x < static_cast<int>(row.size()); ++x)
+                if (solidTiles.count(row[x]))
+                    blocked_[Index(x, y)] = 1;
+        }
+    }
+}
+
+void NavGrid::Clear() {
+    width_ = height_ = 0;
+    blocked_.clear();
+}
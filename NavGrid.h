@@ -0,0 +1,44 @@
+// NavGrid.h
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Flat walkability grid for navigation, one byte per tile. A cell is
+// blocked if any collidable layer has a solid tile there; cells outside
+// the map count as blocked.
+class NavGrid {
+public:
+	void Build(const std::vector<const std::vector<std::vector<int>>*>& layers,
+			   const std::unordered_set<int>& solidTiles,
+			   int tileWidth, int tileHeight);
+	void Clear();
+
+	int GetWidth() const { return width_; }
+	int GetHeight() const { return height_; }
+	int GetCellCount() const { return width_ * height_; }
+	int GetTileWidth() const { return tileWidth_; }
+	int GetTileHeight() const { return tileHeight_; }
+	bool Empty() const { return blocked_.empty(); }
+
+	bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+	bool IsBlocked(int x, int y) const { return !InBounds(x, y) || blocked_[Index(x, y)] != 0; }
+	void SetBlocked(int x, int y, bool blocked) { if (InBounds(x, y)) blocked_[Index(x, y)] = blocked ? 1 : 0; }
+
+	int Index(int x, int y) const { return y * width_ + x; }
+	glm::ivec2 CellOf(int index) const { return { index % width_, index / width_ }; }
+	glm::ivec2 CellAt(glm::vec2 world) const {
+		return { static_cast<int>(world.x) / tileWidth_, static_cast<int>(world.y) / tileHeight_ };
+	}
+	glm::vec2 CellCenter(glm::ivec2 cell) const {
+		return { (cell.x + 0.5f) * tileWidth_, (cell.y + 0.5f) * tileHeight_ };
+	}
+
+private:
+	int width_ = 0, height_ = 0;
+	int tileWidth_ = 16, tileHeight_ = 16;
+	std::vector<std::uint8_t> blocked_;
+};
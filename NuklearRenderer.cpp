@@ -9,6 +9,8 @@
 #define NK_GLFW_GL3_IMPLEMENTATION
 #include "NuklearRenderer.h"
 #include "resource_manager.h"
+#include "GLState.h"
+#include "Stats.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -32,6 +34,9 @@ NuklearRenderer::~NuklearRenderer() {
     nk_buffer_free(&cmds_);
     nk_free(&ctx_);
 
+    GLState::ForgetBuffer(vbo_);
+    GLState::ForgetBuffer(ebo_);
+    GLState::ForgetVertexArray(vao_);
     glDeleteBuffers(1, &vbo_);
     glDeleteBuffers(1, &ebo_);
     glDeleteVertexArrays(1, &vao_);
@@ -49,9 +54,9 @@ void NuklearRenderer::InitResources() {
     glGenBuffers(1, &vbo_);
     glGenBuffers(1, &ebo_);
 
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    GLState::BindVertexArray(vao_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
 
     std::size_t stride = sizeof(float) * 8;
 
@@ -62,7 +67,7 @@ void NuklearRenderer::InitResources() {
     glEnableVertexAttribArray(2); // color
     glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)(sizeof(float) * 4));
 
-    glBindVertexArray(0);
+    GLState::BindVertexArray(0);
 }
 
 void NuklearRenderer::UploadFont() {
@@ -102,22 +107,19 @@ void NuklearRenderer::EndFrame() {
     fbScaleX_ = 1.0f;
     fbScaleY_ = 1.0f;
 
-    glm::mat4 ortho = glm::ortho(0.0f, (float)width_, (float)height_, 0.0f);
-
+    // Projection comes from the per-frame uniform block
     shader_->Use();
-    shader_->SetMatrix4("projection", ortho);
     shader_->SetInteger("Texture", 0);
 
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    GLState::BindVertexArray(vao_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, vbo_);
+    GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
 
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    GLState::SetBlend(true);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::SetCullFace(false);
+    GLState::SetDepthTest(false);
+    GLState::SetScissorTest(true);
 
     const struct nk_draw_command* cmd;
     const nk_draw_index* offset = nullptr;
@@ -159,8 +161,8 @@ void NuklearRenderer::EndFrame() {
     nk_draw_foreach(cmd, &ctx_, &cmds_) {
         if (!cmd->elem_count) continue;
 
-        glBindTexture(GL_TEXTURE_2D, (GLuint)cmd->texture.id);
-        glScissor(
+        GLState::BindTexture((GLuint)cmd->texture.id);
+        GLState::Scissor(
             (GLint)(cmd->clip_rect.x * fbScaleX_),
             (GLint)((height_ - (GLint)(cmd->clip_rect.y + cmd->clip_rect.h)) * fbScaleY_),
             (GLint)(cmd->clip_rect.w * fbScaleX_),
@@ -168,12 +170,12 @@ void NuklearRenderer::EndFrame() {
         );
 
         glDrawElements(GL_TRIANGLES, (GLsizei)cmd->elem_count, GL_UNSIGNED_SHORT, offset);
+        Stats::Add(StatCounter::DrawCalls);
         offset += cmd->elem_count;
     }
 
     nk_clear(&ctx_);
-    glDisable(GL_SCISSOR_TEST);
-    glBindVertexArray(0);
+    GLState::SetScissorTest(false);
 }
 
 nk_context* NuklearRenderer::GetContext() {
@@ -0,0 +1,140 @@
+// Pathfinder.cpp
+#include "Pathfinder.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float DiagonalCost = 1.41421356f;
+
+    struct Step {
+        int dx, dy;
+        float cost;
+    };
+    constexpr Step steps[] = {
+        {  1,  0, 1.0f }, { -1,  0, 1.0f }, { 0,  1, 1.0f }, { 0, -1, 1.0f },
+        {  1,  1, DiagonalCost }, { -1,  1, DiagonalCost },
+        {  1, -1, DiagonalCost }, { -1, -1, DiagonalCost },
+    };
+
+    float Octile(glm::ivec2 a, glm::ivec2 b) {
+        int dx = std::abs(a.x - b.x);
+        int dy = std::abs(a.y - b.y);
+        return static_cast<float>(std::max(dx, dy)) + (DiagonalCost - 1.0f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    // Min-heap on f via the std heap algorithms (which build max-heaps)
+    struct HeapGreater {
+        template <typename T>
+        bool operator()(const T& a, const T& b) const { return a.f > b.f; }
+    };
+}
+
+void Pathfinder::SetGrid(const NavGrid* grid) {
+    grid_ = grid;
+    std::size_t cells = grid ? static_cast<std::size_t>(grid->GetCellCount()) : 0;
+    g_.assign(cells, 0.0f);
+    parent_.assign(cells, -1);
+    visited_.assign(cells, 0);
+    closed_.assign(cells, 0);
+    open_.clear();
+    open_.reserve(cells);
+    stamp_ = 0;
+    ClearCache();
+}
+
+void Pathfinder::ClearCache() {
+    cache_.clear();
+}
+
+const Pathfinder::Path& Pathfinder::FindPath(glm::ivec2 start, glm::ivec2 goal) {
+    static const Path noPath;
+    if (!grid_ || !grid_->InBounds(start.x, start.y) || !grid_->InBounds(goal.x, goal.y))
+        return noPath;
+
+    int s = grid_->Index(start.x, start.y);
+    int t = grid_->Index(goal.x, goal.y);
+    std::uint64_t key = (static_cast<std::uint64_t>(s) << 32) | static_cast<std::uint32_t>(t);
+
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+        ++cacheHits_;
+        return it->second;
+    }
+
+    if (cache_.size() >= MaxCachedPaths)
+        cache_.clear();
+
+    Path& path = cache_[key];
+    Search(s, t, path);
+    return path;
+}
+
+void Pathfinder::Search(int start, int goal, Path& out) {
+    ++searches_;
+    out.cells.clear();
+    out.found = false;
+
+    if (grid_->IsBlocked(grid_->CellOf(goal).x, grid_->CellOf(goal).y))
+        return;
+    if (start == goal) {
+        out.found = true;
+        return;
+    }
+
+    // New stamp invalidates every node from earlier searches at once
+    if (++stamp_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        stamp_ = 1;
+    }
+
+    const glm::ivec2 goalCell = grid_->CellOf(goal);
+    open_.clear();
+    g_[start] = 0.0f;
+    parent_[start] = -1;
+    visited_[start] = stamp_;
+    open_.push_back({ Octile(grid_->CellOf(start), goalCell), start });
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), HeapGreater{});
+        int node = open_.back().node;
+        open_.pop_back();
+
+        // Stale duplicate left behind by a later, cheaper push
+        if (closed_[node] == stamp_) continue;
+        closed_[node] = stamp_;
+
+        if (node == goal) break;
+
+        glm::ivec2 cell = grid_->CellOf(node);
+        for (const Step& step : steps) {
+            int nx = cell.x + step.dx;
+            int ny = cell.y + step.dy;
+            if (grid_->IsBlocked(nx, ny)) continue;
+            // No squeezing diagonally between two blocked tiles / around corners
+            if (step.dx != 0 && step.dy != 0 &&
+                (grid_->IsBlocked(cell.x + step.dx, cell.y) || grid_->IsBlocked(cell.x, cell.y + step.dy)))
+                continue;
+
+            int next = grid_->Index(nx, ny);
+            if (closed_[next] == stamp_) continue;
+
+            float g = g_[node] + step.cost;
+            if (visited_[next] == stamp_ && g >= g_[next]) continue;
+
+            visited_[next] = stamp_;
+            g_[next] = g;
+            parent_[next] = node;
+            open_.push_back({ g + Octile({ nx, ny }, goalCell), next });
+            std::push_heap(open_.begin(), open_.end(), HeapGreater{});
+        }
+    }
+
+    if (closed_[goal] != stamp_) return;
+
+    for (int node = goal; node != start; node = parent_[node])
+        out.cells.push_back(grid_->CellOf(node));
+    std::reverse(out.cells.begin(), out.cells.end());
+    out.found = true;
+}
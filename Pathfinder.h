@@ -0,0 +1,61 @@
+// Pathfinder.h
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "NavGrid.h"
+
+// A* over a NavGrid (8-connected, no corner cutting, octile heuristic).
+// Node arrays and the open-list heap are sized once per grid and reused by
+// every search; a search stamp marks which entries belong to the current
+// search, so nothing is cleared between queries.
+//
+// Results are cached by (start cell, goal cell). Not thread-safe: query it
+// from one thread (EnemyStore does so before its parallel update).
+class Pathfinder {
+public:
+	// Cells from start to goal, excluding start. Empty if start == goal.
+	struct Path {
+		bool found = false;
+		std::vector<glm::ivec2> cells;
+	};
+
+	void SetGrid(const NavGrid* grid);
+	const NavGrid* GetGrid() const { return grid_; }
+
+	// Returns the cached path if there is one; the reference stays valid
+	// until the next FindPath/ClearCache call
+	const Path& FindPath(glm::ivec2 start, glm::ivec2 goal);
+	void ClearCache();
+
+	std::uint64_t GetSearchCount() const { return searches_; }
+	std::uint64_t GetCacheHits() const { return cacheHits_; }
+
+	// Cap on cached results; the cache is dropped wholesale when it fills
+	static constexpr std::size_t MaxCachedPaths = 1024;
+
+private:
+	void Search(int start, int goal, Path& out);
+
+	struct OpenEntry {
+		float f;
+		int node;
+	};
+
+	const NavGrid* grid_ = nullptr;
+
+	std::vector<float> g_;
+	std::vector<int> parent_;
+	std::vector<std::uint32_t> visited_;   // == stamp_: g_/parent_ valid this search
+	std::vector<std::uint32_t> closed_;    // == stamp_: expanded this search
+	std::vector<OpenEntry> open_;
+	std::uint32_t stamp_ = 0;
+
+	std::unordered_map<std::uint64_t, Path> cache_;
+	std::uint64_t searches_ = 0;
+	std::uint64_t cacheHits_ = 0;
+};
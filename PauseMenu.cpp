@@ -11,6 +11,8 @@
 #include "Collision.h"
 #include "RESOURCE_MANAGER.h"
 #include "TEXT_RENDERER.h"
+#include "GLState.h"
+#include "Stats.h"
 
 PauseMenu::PauseMenu()
     : active_(false), selectedIndex_(0),
@@ -47,9 +49,9 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
     screenWidth_ = screenWidth;
     screenHeight_ = screenHeight;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
+    GLState::SetBlend(true);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::SetDepthTest(false);
 
     initRenderData();
 
@@ -59,13 +61,12 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
     shader->SetVector4f("overlayColor", glm::vec4(0.36f, 0.36f, 0.35f, 0.4f));
     shader->SetInteger("image", 0);
 
-    glBindVertexArray(quadVAO_);
+    GLState::BindVertexArray(quadVAO_);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    Stats::Add(StatCounter::DrawCalls);
 
     TextRenderer& textTitle = ResourceManager::GetTextRenderer("pause");    // big title
     TextRenderer& textMenu  = ResourceManager::GetTextRenderer("default");  // smaller menu items
-    glm::mat4 projection = glm::ortho(0.0f, screenWidth_, screenHeight_, 0.0f);
     float centerX = screenWidth_ / 2.0f;
     float scaleTitle = 2.0f;
     float scaleOption = 1.5f;
@@ -76,7 +77,7 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
         float titleY = screenHeight_ / 2.0f - 150.0f;
 
         // Use title font for the title
-        RenderOption(title, titleX, titleY, scaleTitle, glm::vec3(1.0f), projection, "pause");
+        RenderOption(title, titleX, titleY, scaleTitle, glm::vec3(1.0f), "pause");
 
         float spacing = 60.0f;
         float optionYStart = titleY + 100.0f;
@@ -90,7 +91,7 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
             float y = optionYStart + i * spacing;
 
             glm::vec3 color = (i == hoveredIndex_) ? glm::vec3(0.0f) : glm::vec3(1.0f);
-            RenderOption(label, x, y, scaleOption, color, projection, "default");
+            RenderOption(label, x, y, scaleOption, color, "default");
             // if (i == selectedIndex_) {
             //     auto bounds = GetOptionBounds(i, screenWidth_, screenHeight_, scaleOption);
             //     RenderSelectionBox(bounds.x, bounds.y, bounds.width, bounds.height, glm::vec4(1.0f, 0.0f, 0.0f, 0.3f), projection);
@@ -103,7 +104,7 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
         float headerY = screenHeight_ / 2.0f - 150.0f;
 
         // Use title font for the header
-        RenderOption(header, centerX - headerWidth / 2.0f, headerY, scaleOption, glm::vec3(1.0f), projection, "pause");
+        RenderOption(header, centerX - headerWidth / 2.0f, headerY, scaleOption, glm::vec3(1.0f), "pause");
 
         float spacing = 60.0f;
         float optionYStart = headerY + 100.0f;
@@ -121,7 +122,7 @@ void PauseMenu::Render(float screenWidth, float screenHeight) {
             levelOptionPositions_.emplace_back(x, y);
 
             glm::vec3 color = (i == hoveredLevelIndex_) ? glm::vec3(0.0f) : glm::vec3(1.0f);
-            RenderOption(label, x, y, scaleOption, color, projection, "default");
+            RenderOption(label, x, y, scaleOption, color, "default");
             // if (i == selectedLevelIndex_) {
             //     auto bounds = GetLevelBounds(i, screenWidth_, screenHeight_, scaleOption);
             //     RenderSelectionBox(bounds.x, bounds.y, bounds.width, bounds.height, glm::vec4(1.0f, 0.0f, 0.0f, 0.3f), projection);
@@ -216,8 +217,8 @@ void PauseMenu::initRenderData() {
 
         glGenVertexArrays(1, &quadVAO_);
         glGenBuffers(1, &quadVBO_);
-        glBindVertexArray(quadVAO_);
-        glBindBuffer(GL_ARRAY_BUFFER, quadVBO_);
+        GLState::BindVertexArray(quadVAO_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO_);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
@@ -226,24 +227,26 @@ void PauseMenu::initRenderData() {
     if (boxVAO_ == 0) {
         glGenVertexArrays(1, &boxVAO_);
         glGenBuffers(1, &boxVBO_);
-        glBindVertexArray(boxVAO_);
-        glBindBuffer(GL_ARRAY_BUFFER, boxVBO_);
+        GLState::BindVertexArray(boxVAO_);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, boxVBO_);
         glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 2 * 6, nullptr, GL_DYNAMIC_DRAW);
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindVertexArray(0);
 }
 PauseMenu::~PauseMenu() {
+    GLState::ForgetVertexArray(quadVAO_);
+    GLState::ForgetBuffer(quadVBO_);
     if (quadVAO_) glDeleteVertexArrays(1, &quadVAO_);
     if (quadVBO_) glDeleteBuffers(1, &quadVBO_);
 
 }
-void PauseMenu::RenderOption(const std::string& text, float x, float y, float scale, const glm::vec3& color, const glm::mat4& proj, const std::string& rendererName) {
+void PauseMenu::RenderOption(const std::string& text, float x, float y, float scale, const glm::vec3& color, const std::string& rendererName) {
     TextRenderer& textRenderer = ResourceManager::GetTextRenderer(rendererName);
-    textRenderer.RenderText(text, x, y, scale, color, proj);
+    textRenderer.RenderText(text, x, y, scale, color);
 }
 
 
@@ -255,8 +258,8 @@ void PauseMenu::RenderSelectionBox(float x, float y, float width, float height,
         {x, y + height}, {x + width, y}, {x + width, y + height}
     };
 
-    glBindVertexArray(boxVAO_);
-    glBindBuffer(GL_ARRAY_BUFFER, boxVBO_);
+    GLState::BindVertexArray(boxVAO_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, boxVBO_);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
     auto shader = ResourceManager::GetShader("box");
@@ -265,7 +268,7 @@ void PauseMenu::RenderSelectionBox(float x, float y, float width, float height,
     shader->SetVector4f("color", color);
 
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    Stats::Add(StatCounter::DrawCalls);
 }
 void PauseMenu::OnMouseMove(float mx, float my) {
     hoveredIndex_ = -1;
@@ -60,7 +60,7 @@ private:
 	Mode currentMode_ = Mode::MAIN;
 	std::vector<std::string> options_;
 	std::vector<std::string> levelNames_;
-	void RenderOption(const ::std::string &text, float x, float y, float scale, const glm::vec3 & color, const glm::mat4 & proj, const std::
+	void RenderOption(const ::std::string &text, float x, float y, float scale, const glm::vec3 & color, const std::
 	                  string &rendererName);
 	void RenderSelectionBox(float x, float y, float width, float height, const glm::vec4& color, const glm::mat4& proj);
 
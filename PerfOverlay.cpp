@@ -0,0 +1,84 @@
+// PerfOverlay.cpp
+#include "PerfOverlay.h"
+
+#include <cstdio>
+
+#include "RESOURCE_MANAGER.h"
+#include "Stats.h"
+
+namespace {
+    void LabelValue(nk_context* ctx, const char* name, const char* value) {
+        nk_label(ctx, name, NK_TEXT_LEFT);
+        nk_label(ctx, value, NK_TEXT_RIGHT);
+    }
+}
+
+void PerfOverlay::Render(nk_context* ctx, float screenWidth, float screenHeight) {
+    if (!visible_ || !ctx) return;
+
+    const Stats::FrameStats& frame = Stats::LastFrame();
+    char buf[64];
+
+    float width = 340.0f;
+    float height = screenHeight * 0.7f;
+
+    if (nk_begin(ctx, "Performance", nk_rect(screenWidth - width - 10.0f, 10.0f, width, height),
+                 NK_WINDOW_BORDER | NK_WINDOW_TITLE | NK_WINDOW_MOVABLE | NK_WINDOW_MINIMIZABLE)) {
+        // Frame time graph
+        float avgMs = Stats::FrameHistoryAverage();
+        float maxMs = Stats::FrameHistoryMax();
+        std::snprintf(buf, sizeof(buf), "%.2f ms (%.0f fps)  max %.2f", avgMs, avgMs > 0.0f ? 1000.0f / avgMs : 0.0f, maxMs);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buf, NK_TEXT_LEFT);
+        // Pacing quality: how much frame times wander around the average
+        std::snprintf(buf, sizeof(buf), "stddev %.3f ms", Stats::FrameHistoryStdDev());
+        nk_label(ctx, buf, NK_TEXT_LEFT);
+
+        nk_layout_row_dynamic(ctx, 80, 1);
+        int samples = static_cast<int>(Stats::HistoryCount());
+        if (samples > 0 && nk_chart_begin(ctx, NK_CHART_LINES, samples, 0.0f, maxMs > 0.0f ? maxMs : 1.0f)) {
+            for (int i = 0; i < samples; ++i)
+                nk_chart_push(ctx, Stats::FrameHistoryAt(i));
+            nk_chart_end(ctx);
+        }
+
+        // Per-phase timings
+        nk_layout_row_dynamic(ctx, 18, 3);
+        nk_label(ctx, "Phase", NK_TEXT_LEFT);
+        nk_label(ctx, "CPU ms", NK_TEXT_RIGHT);
+        nk_label(ctx, "GPU ms", NK_TEXT_RIGHT);
+        for (std::size_t p = 0; p < Stats::PhaseCount; ++p) {
+            nk_label(ctx, Stats::Name(static_cast<StatPhase>(p)), NK_TEXT_LEFT);
+            std::snprintf(buf, sizeof(buf), "%.3f", frame.cpuMs[p]);
+            nk_label(ctx, buf, NK_TEXT_RIGHT);
+            std::snprintf(buf, sizeof(buf), "%.3f", frame.gpuMs[p]);
+            nk_label(ctx, buf, NK_TEXT_RIGHT);
+        }
+
+        // Counters
+        nk_layout_row_dynamic(ctx, 18, 2);
+        for (std::size_t c = 0; c < Stats::CounterCount; ++c) {
+            std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(frame.counters[c]));
+            LabelValue(ctx, Stats::Name(static_cast<StatCounter>(c)), buf);
+        }
+
+        // Memory held by ResourceManager
+        std::snprintf(buf, sizeof(buf), "%.2f MB", ResourceManager::GetTextureMemoryUsage() / (1024.0 * 1024.0));
+        LabelValue(ctx, "Texture memory", buf);
+        std::snprintf(buf, sizeof(buf), "%.1f KB", ResourceManager::GetBufferMemoryUsage() / 1024.0);
+        LabelValue(ctx, "Buffer memory", buf);
+
+        // Recent level loads, newest first
+        nk_layout_row_dynamic(ctx, 18, 1);
+        nk_label(ctx, "Level loads:", NK_TEXT_LEFT);
+        nk_layout_row_dynamic(ctx, 18, 2);
+        const auto& loads = Stats::LevelLoads();
+        for (std::size_t i = Stats::LevelLoadCount(); i-- > 0;) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "  Level %d", loads[i].index);
+            std::snprintf(buf, sizeof(buf), "%.2f ms", loads[i].ms);
+            LabelValue(ctx, name, buf);
+        }
+    }
+    nk_end(ctx);
+}
@@ -0,0 +1,18 @@
+// PerfOverlay.h
+#pragma once
+
+#include "NuklearRenderer.h"
+
+// Toggleable Nuklear window showing the numbers collected in Stats:
+// frame-time graph, per-phase CPU/GPU timings, per-frame counters,
+// resource memory and recent level-load durations.
+class PerfOverlay {
+public:
+	void Toggle() { visible_ = !visible_; }
+	bool IsVisible() const { return visible_; }
+
+	void Render(struct nk_context* ctx, float screenWidth, float screenHeight);
+
+private:
+	bool visible_ = false;
+};
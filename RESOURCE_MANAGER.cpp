@@ -1,5 +1,6 @@
 #include "resource_manager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -11,12 +12,25 @@
 #include <glad/glad.h>
 
 #include "stb_image.h"
+#include "GLState.h"
+#include "Log.h"
+#include "TextureAtlas.h"
 
 // Static maps
 std::unordered_map<std::string, std::shared_ptr<Texture2D>> ResourceManager::Textures;
 std::unordered_map<std::string, std::shared_ptr<Shader>>    ResourceManager::Shaders;
 std::map<std::string, std::shared_ptr<TextRenderer>>        ResourceManager::TextRenderers;
 
+// Atlas regions by file path, with the number of holders
+struct AtlasEntry {
+    TextureRegion region;
+    int refs = 0;
+};
+static std::unordered_map<std::string, AtlasEntry> atlasEntries;
+
+// Largest page we pack into, whatever the driver allows
+constexpr int MaxAtlasPageSize = 4096;
+
 // Track file paths for reload detection
 static std::unordered_map<std::string, std::string> texturePaths;
 static std::unordered_map<std::string, std::pair<std::string, std::string>> shaderPaths;
@@ -59,8 +73,10 @@ std::shared_ptr<Shader> ResourceManager::LoadShader(const char* vShaderFile, con
         if (oldVS == vsPath && oldFS == fsPath)
             return it->second;
 
-        if (it->second && it->second->ID != 0)
+        if (it->second && it->second->ID != 0) {
+            GLState::ForgetProgram(it->second->ID);
             glDeleteProgram(it->second->ID);
+        }
 
         Shaders.erase(it);
         shaderPaths.erase(name);
@@ -88,18 +104,114 @@ std::shared_ptr<Shader> ResourceManager::GetShader(const std::string& name) {
     return nullptr;
 }
 
+// Atlas regions
+std::vector<TextureRegion> ResourceManager::AcquireAtlasRegions(const std::vector<std::string>& files)
+{
+    // Decode only the files no atlas holds yet
+    std::vector<std::string> newFiles;
+    std::vector<AtlasImage> images;
+    for (const auto& file : files) {
+        if (atlasEntries.count(file) || std::find(newFiles.begin(), newFiles.end(), file) != newFiles.end())
+            continue;
+        int w = 0, h = 0, _ = 0;
+        stbi_uc* data = stbi_load(file.c_str(), &w, &h, &_, STBI_rgb_alpha);
+        if (!data) {
+            LOG_ERROR("❌ Failed to load texture: %s", file.c_str());
+            continue;
+        }
+        newFiles.push_back(file);
+        images.push_back({ w, h, data });
+    }
+
+    if (!images.empty()) {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        TextureAtlasBuilder builder(std::min<int>(maxSize, MaxAtlasPageSize));
+
+        if (builder.Pack(images)) {
+            std::vector<std::shared_ptr<Texture2D>> pages;
+            for (int p = 0; p < builder.GetPageCount(); ++p) {
+                std::vector<unsigned char> pixels = builder.Compose(p, images);
+                auto page = std::make_shared<Texture2D>();
+                page->Internal_Format = GL_RGBA;
+                page->Image_Format    = GL_RGBA;
+                page->Generate(builder.GetPageSize(p).x, builder.GetPageSize(p).y, pixels.data());
+                pages.push_back(std::move(page));
+            }
+            for (std::size_t i = 0; i < newFiles.size(); ++i)
+                atlasEntries[newFiles[i]].region = { pages[builder.GetPage(i)], builder.GetRegion(i) };
+        } else {
+            // Too big for one page: that image gets a texture of its own
+            for (std::size_t i = 0; i < newFiles.size(); ++i) {
+                auto tex = std::make_shared<Texture2D>();
+                tex->Internal_Format = GL_RGBA;
+                tex->Image_Format    = GL_RGBA;
+                tex->Generate(images[i].width, images[i].height, images[i].pixels);
+                atlasEntries[newFiles[i]].region = { std::move(tex), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f) };
+            }
+        }
+        for (auto& img : images)
+            stbi_image_free(const_cast<unsigned char*>(img.pixels));
+    }
+
+    std::vector<TextureRegion> regions;
+    regions.reserve(files.size());
+    for (const auto& file : files) {
+        auto it = atlasEntries.find(file);
+        if (it == atlasEntries.end()) {
+            regions.push_back({});
+            continue;
+        }
+        ++it->second.refs;
+        regions.push_back(it->second.region);
+    }
+    return regions;
+}
+
+void ResourceManager::ReleaseAtlasRegions(const std::vector<std::string>& files)
+{
+    for (const auto& file : files) {
+        auto it = atlasEntries.find(file);
+        if (it == atlasEntries.end() || --it->second.refs > 0) continue;
+
+        std::shared_ptr<Texture2D> page = it->second.region.texture;
+        atlasEntries.erase(it);
+
+        // The page goes once no file on it is held any more
+        bool pageInUse = std::any_of(atlasEntries.begin(), atlasEntries.end(),
+                                     [&](const auto& e) { return e.second.region.texture == page; });
+        if (!pageInUse && page && page->ID != 0) {
+            GLState::ForgetTexture(page->ID);
+            glDeleteTextures(1, &page->ID);
+            page->ID = 0;
+        }
+    }
+}
+
 // Clear all
 void ResourceManager::Clear() {
     for (auto& [_, shader] : Shaders)
-        if (shader && shader->ID != 0)
+        if (shader && shader->ID != 0) {
+            GLState::ForgetProgram(shader->ID);
             glDeleteProgram(shader->ID);
+        }
 
     for (auto& [_, texture] : Textures)
-        if (texture && texture->ID != 0)
+        if (texture && texture->ID != 0) {
+            GLState::ForgetTexture(texture->ID);
             glDeleteTextures(1, &texture->ID);
+        }
+
+    for (auto& [_, entry] : atlasEntries)
+        if (entry.region.texture && entry.region.texture->ID != 0) {
+            GLState::ForgetTexture(entry.region.texture->ID);
+            glDeleteTextures(1, &entry.region.texture->ID);
+            entry.region.texture->ID = 0;
+        }
 
     Shaders.clear();
     Textures.clear();
+    atlasEntries.clear();
     TextRenderers.clear();
     texturePaths.clear();
     shaderPaths.clear();
@@ -161,8 +273,10 @@ TextRenderer& ResourceManager::GetTextRenderer(const std::string& name) {
 void ResourceManager::UnloadTexture(const std::string& name) {
     auto it = Textures.find(name);
     if (it != Textures.end()) {
-        if (it->second && it->second->ID != 0)
+        if (it->second && it->second->ID != 0) {
+            GLState::ForgetTexture(it->second->ID);
             glDeleteTextures(1, &it->second->ID);
+        }
         Textures.erase(it);
         texturePaths.erase(name);
     }
@@ -171,8 +285,10 @@ void ResourceManager::UnloadTexture(const std::string& name) {
 void ResourceManager::UnloadShader(const std::string& name) {
     auto it = Shaders.find(name);
     if (it != Shaders.end()) {
-        if (it->second && it->second->ID != 0)
+        if (it->second && it->second->ID != 0) {
+            GLState::ForgetProgram(it->second->ID);
             glDeleteProgram(it->second->ID);
+        }
         Shaders.erase(it);
         shaderPaths.erase(name);
     }
@@ -182,3 +298,32 @@ std::shared_ptr<TextRenderer> ResourceManager::GetTextRendererPtr(const std::str
     if (it != TextRenderers.end()) return it->second;
     throw std::runtime_error("TextRenderer '" + name + "' not found");
 }
+
+std::size_t ResourceManager::GetTextureMemoryUsage() {
+    std::size_t bytes = 0;
+    for (const auto& [_, texture] : Textures)
+        if (texture)
+            bytes += static_cast<std::size_t>(texture->Width) * texture->Height * 4; // always RGBA8
+
+    // Atlas pages are shared by several files; count each page once
+    std::vector<const Texture2D*> pages;
+    for (const auto& [_, entry] : atlasEntries) {
+        const Texture2D* page = entry.region.texture.get();
+        if (!page || std::find(pages.begin(), pages.end(), page) != pages.end()) continue;
+        pages.push_back(page);
+        bytes += static_cast<std::size_t>(page->Width) * page->Height * 4;
+    }
+
+    for (const auto& [_, renderer] : TextRenderers)
+        if (renderer)
+            bytes += renderer->GetTextureMemoryUsage();
+    return bytes;
+}
+
+std::size_t ResourceManager::GetBufferMemoryUsage() {
+    std::size_t bytes = 0;
+    for (const auto& [_, renderer] : TextRenderers)
+        if (renderer)
+            bytes += renderer->GetBufferMemoryUsage();
+    return bytes;
+}
@@ -6,6 +6,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 //#include <glad/glad.h>
 
@@ -14,6 +17,13 @@
 #include "TEXT_RENDERER.h"
 
 
+// Part of a texture: uv offset (xy) and scale (zw) of an image inside a
+// shared atlas page. Map a sheet-local uvRect into it with RemapUV.
+struct TextureRegion {
+    std::shared_ptr<Texture2D> texture;
+    glm::vec4 rect{ 0.0f, 0.0f, 1.0f, 1.0f };
+};
+
 // A static singleton ResourceManager class that hosts several
 // functions to load Textures and Shaders. Each loaded texture
 // and/or shader is also stored for future reference by string
@@ -40,10 +50,21 @@ static std::map<std::string, std::shared_ptr<TextRenderer>> TextRenderers;
     static std::shared_ptr<TextRenderer> LoadTextRenderer(const std::string& name, unsigned int width, unsigned int height);
 static TextRenderer& GetTextRenderer(const std::string& name);
     static void UnloadTexture(const std::string& name);
+
+    // Sprite sheets and tilesets go into shared atlas pages so world draws
+    // don't have to switch textures. Files already in an atlas are reused;
+    // the rest are packed together into new pages. Reference counted per
+    // file: pair every Acquire with a Release of the same files.
+    static std::vector<TextureRegion> AcquireAtlasRegions(const std::vector<std::string>& files);
+    static void ReleaseAtlasRegions(const std::vector<std::string>& files);
     static void UnloadShader(const std::string& name);
 
     static std::shared_ptr<TextRenderer> GetTextRendererPtr(const std::string& name);
 
+    // approximate GPU memory held by loaded textures / text renderer buffers, in bytes
+    static std::size_t GetTextureMemoryUsage();
+    static std::size_t GetBufferMemoryUsage();
+
 private:
     // private constructor, that is we do not want any actual resource manager objects. Its members and functions should be publicly available (static).
     ResourceManager() { }
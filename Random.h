@@ -0,0 +1,75 @@
+// Random.h
+#pragma once
+
+#include <cstdint>
+
+// Seed derivation helpers. A game seed is mixed with a level index to get the
+// level seed, and each entity draws from its own stream of that seed, so the
+// numbers an entity sees never depend on update order or thread.
+namespace Random {
+	// SplitMix64 step: advances state and returns a well-mixed value
+	inline std::uint64_t SplitMix64(std::uint64_t& state) {
+		std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Derives a child seed (e.g. level seed from the game seed and level index)
+	inline std::uint64_t Combine(std::uint64_t seed, std::uint64_t key) {
+		std::uint64_t state = seed ^ (key * 0xD1B54A32D192ED03ull);
+		return SplitMix64(state);
+	}
+}
+
+// PCG32 (XSH RR): 16 bytes of state, no shared globals. Each stream id picks
+// an independent sequence for the same seed.
+class Rng {
+public:
+	Rng() { Seed(0, 0); }
+	Rng(std::uint64_t seed, std::uint64_t stream) { Seed(seed, stream); }
+
+	void Seed(std::uint64_t seed, std::uint64_t stream) {
+		state_ = 0;
+		inc_ = (stream << 1u) | 1u;
+		NextU32();
+		state_ += Random::SplitMix64(seed);
+		NextU32();
+	}
+
+	std::uint32_t NextU32() {
+		std::uint64_t old = state_;
+		state_ = old * 6364136223846793005ull + inc_;
+		auto xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+		auto rot = static_cast<std::uint32_t>(old >> 59u);
+		return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+	}
+
+	// Uniform in [0, bound) without modulo bias (Lemire's multiply-shift)
+	std::uint32_t NextBelow(std::uint32_t bound) {
+		std::uint64_t m = static_cast<std::uint64_t>(NextU32()) * bound;
+		auto low = static_cast<std::uint32_t>(m);
+		if (low < bound) {
+			std::uint32_t threshold = (0u - bound) % bound;
+			while (low < threshold) {
+				m = static_cast<std::uint64_t>(NextU32()) * bound;
+				low = static_cast<std::uint32_t>(m);
+			}
+		}
+		return static_cast<std::uint32_t>(m >> 32);
+	}
+
+	// Uniform in [lo, hi]
+	int NextInt(int lo, int hi) {
+		return lo + static_cast<int>(NextBelow(static_cast<std::uint32_t>(hi - lo) + 1u));
+	}
+
+	// Uniform in [0, 1)
+	float NextFloat() {
+		return static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f);
+	}
+
+private:
+	std::uint64_t state_;
+	std::uint64_t inc_;
+};
@@ -0,0 +1,181 @@
+// RenderQueue.cpp
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include "GLState.h"
+#include "SHADER.h"
+#include "Stats.h"
+#include "TEXTURE.h"
+
+namespace {
+    // Matches the sprite shader's inputs: location 0 position, 1 uv
+    struct SpriteVertex {
+        glm::vec2 position;
+        glm::vec2 uv;
+    };
+    constexpr std::size_t VerticesPerSprite = 6;
+    // Quads expanded per job; a few thousand keeps the jobs worth handing out
+    constexpr std::size_t BuildChunkSize = 2048;
+
+    // One stream buffer shared by every queue: all execution happens on the
+    // GL thread, one queue at a time
+    GLuint batchVAO = 0;
+    GLuint batchVBO = 0;
+
+    void InitBatchBuffer() {
+        glGenVertexArrays(1, &batchVAO);
+        glGenBuffers(1, &batchVBO);
+        GLState::BindVertexArray(batchVAO);
+        GLState::BindBuffer(GL_ARRAY_BUFFER, batchVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, uv));
+    }
+
+    // Two triangles in world space: translate(position) * rotate about the
+    // centre * scale(size) applied to the unit quad, uvRect applied to its uvs
+    void WriteQuad(const SpriteCommand& cmd, SpriteVertex* out) {
+        glm::vec2 axisX(cmd.size.x, 0.0f), axisY(0.0f, cmd.size.y), origin = cmd.position;
+        if (cmd.rotation != 0.0f) {
+            float c = std::cos(cmd.rotation), s = std::sin(cmd.rotation);
+            glm::vec2 half = cmd.size * 0.5f;
+            axisX = glm::vec2(c, s) * cmd.size.x;
+            axisY = glm::vec2(-s, c) * cmd.size.y;
+            origin = cmd.position + half - glm::vec2(c * half.x - s * half.y, s * half.x + c * half.y);
+        }
+
+        const glm::vec2 uv0(cmd.uvRect.x, cmd.uvRect.y);
+        const glm::vec2 uv1 = uv0 + glm::vec2(cmd.uvRect.z, cmd.uvRect.w);
+        const SpriteVertex topLeft{ origin, uv0 };
+        const SpriteVertex topRight{ origin + axisX, { uv1.x, uv0.y } };
+        const SpriteVertex bottomLeft{ origin + axisY, { uv0.x, uv1.y } };
+        const SpriteVertex bottomRight{ origin + axisX + axisY, uv1 };
+
+        // Same winding as the old unit quad
+        out[0] = bottomLeft; out[1] = topRight; out[2] = topLeft;
+        out[3] = bottomLeft; out[4] = bottomRight; out[5] = topRight;
+    }
+}
+
+std::uint64_t RenderQueue::MakeKey(std::uint8_t layer, unsigned int shader, unsigned int texture, std::uint32_t depth) {
+    return (static_cast<std::uint64_t>(layer) << 56) |
+           (static_cast<std::uint64_t>(shader & 0xFFFu) << 44) |
+           (static_cast<std::uint64_t>(texture & 0xFFFFFu) << 24) |
+           static_cast<std::uint64_t>(std::min<std::uint32_t>(depth, 0xFFFFFFu));
+}
+
+std::uint64_t RenderQueue::MakeKey(std::uint8_t layer, const SpriteCommand& cmd, std::uint32_t depth) {
+    return MakeKey(layer, cmd.shader ? cmd.shader->ID : 0u, cmd.texture ? cmd.texture->ID : 0u, depth);
+}
+
+void RenderQueue::Reserve(std::size_t count) {
+    commands_.reserve(count);
+    keys_.reserve(count);
+}
+
+void RenderQueue::Submit(std::uint64_t key, const SpriteCommand& cmd) {
+    keys_.push_back({ key, static_cast<std::uint32_t>(commands_.size()) });
+    commands_.push_back(cmd);
+}
+
+void RenderQueue::Append(RenderQueue& other) {
+    auto base = static_cast<std::uint32_t>(commands_.size());
+    commands_.insert(commands_.end(), other.commands_.begin(), other.commands_.end());
+    for (const SortEntry& e : other.keys_)
+        keys_.push_back({ e.key, base + e.index });
+    other.Clear();
+}
+
+void RenderQueue::Clear() {
+    commands_.clear();
+    keys_.clear();
+    order_.clear();
+}
+
+void RenderQueue::Sort() {
+    // LSD radix sort, a byte per pass; passes where every key has the same
+    // byte (the layer byte, usually most of the shader bits) are skipped
+    const std::size_t n = keys_.size();
+    scratch_.resize(n);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        std::array<std::size_t, 257> offsets{};
+        for (const SortEntry& e : keys_)
+            ++offsets[((e.key >> shift) & 0xFF) + 1];
+        if (std::find(offsets.begin() + 1, offsets.end(), n) != offsets.end())
+            continue;
+
+        for (std::size_t b = 1; b < offsets.size(); ++b)
+            offsets[b] += offsets[b - 1];
+        for (const SortEntry& e : keys_)
+            scratch_[offsets[(e.key >> shift) & 0xFF]++] = e;
+        keys_.swap(scratch_);
+    }
+
+    order_.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order_[i] = keys_[i].index;
+}
+
+void RenderQueue::Execute() {
+    if (commands_.empty()) return;
+    Sort();
+
+    const std::size_t n = order_.size();
+    const std::size_t bytes = n * VerticesPerSprite * sizeof(SpriteVertex);
+    if (!batchVAO) InitBatchBuffer();
+
+    // Orphan last draw's storage and fill the new one from the job system;
+    // job j only touches the quads of its own commands
+    GLState::BindVertexArray(batchVAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, batchVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    auto* vertices = static_cast<SpriteVertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (!vertices) {
+        Clear();
+        return;
+    }
+    JobSystem::ParallelFor(n, BuildChunkSize, [this, vertices](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            WriteQuad(commands_[order_[i]], vertices + i * VerticesPerSprite);
+    });
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    // One draw per run of equal shader and texture
+    std::size_t runStart = 0;
+    for (std::size_t i = 1; i <= n; ++i) {
+        const SpriteCommand& first = commands_[order_[runStart]];
+        if (i < n) {
+            const SpriteCommand& cmd = commands_[order_[i]];
+            if (cmd.shader == first.shader && cmd.texture == first.texture) continue;
+        }
+
+        if (first.shader && first.texture) {
+            first.shader->Use();
+            first.texture->Bind();
+            glDrawArrays(GL_TRIANGLES, static_cast<GLint>(runStart * VerticesPerSprite),
+                         static_cast<GLsizei>((i - runStart) * VerticesPerSprite));
+            Stats::Add(StatCounter::DrawCalls);
+        }
+        runStart = i;
+    }
+
+    Clear();
+}
+
+void RenderQueue::Shutdown() {
+    if (!batchVAO) return;
+    GLState::ForgetBuffer(batchVBO);
+    GLState::ForgetVertexArray(batchVAO);
+    glDeleteBuffers(1, &batchVBO);
+    glDeleteVertexArrays(1, &batchVAO);
+    batchVBO = batchVAO = 0;
+}
@@ -0,0 +1,93 @@
+// RenderQueue.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "JobSystem.h"
+
+class Shader;
+class Texture2D;
+
+// One textured quad, placed at position with size and rotated by rotation
+// radians about its centre
+struct SpriteCommand {
+	Shader* shader = nullptr;
+	const Texture2D* texture = nullptr;
+	glm::vec2 position{ 0.0f };
+	glm::vec2 size{ 0.0f };
+	float rotation = 0.0f;
+	glm::vec4 uvRect{ 0.0f, 0.0f, 1.0f, 1.0f };
+};
+
+// Deferred sprite submission. Systems Submit commands tagged with a sort
+// key; Execute radix-sorts the keys, expands the commands into quads in a
+// mapped vertex buffer (in parallel, each job writing its own slice) and
+// draws each run of equal shader and texture with a single call on the GL
+// thread. The draw order comes from the keys rather than from who drew
+// first, and commands sharing a shader and texture end up adjacent.
+// Building commands touches no GL state; SubmitParallel spreads it over
+// the job system.
+//
+// Key layout, most significant first:
+//   layer   8 bits   draw order between passes (tile layers, enemies, player)
+//   shader 12 bits   program id
+//   texture 20 bits  texture id
+//   depth  24 bits   back to front within the same material
+// Equal keys keep their submission order.
+class RenderQueue {
+public:
+	static std::uint64_t MakeKey(std::uint8_t layer, unsigned int shader, unsigned int texture, std::uint32_t depth);
+	static std::uint64_t MakeKey(std::uint8_t layer, const SpriteCommand& cmd, std::uint32_t depth);
+
+	void Reserve(std::size_t count);
+	void Submit(std::uint64_t key, const SpriteCommand& cmd);
+
+	// Builds commands for [0, count) on the job system, grain items per job:
+	// fn(begin, end, out) submits into out, a queue of the job's own. They
+	// are appended in index order, so the result never depends on timing.
+	template <typename F>
+	void SubmitParallel(std::size_t count, std::size_t grain, F&& fn) {
+		if (count == 0) return;
+		grain = grain > 0 ? grain : 1;
+		std::size_t jobs = (count + grain - 1) / grain;
+		if (locals_.size() < jobs) locals_.resize(jobs);
+		JobSystem::ParallelFor(count, grain, [this, grain, &fn](std::size_t begin, std::size_t end) {
+			fn(begin, end, locals_[begin / grain]);
+		});
+		for (std::size_t j = 0; j < jobs; ++j)
+			Append(locals_[j]);
+	}
+
+	// Moves other's commands to the end of this queue
+	void Append(RenderQueue& other);
+	void Clear();
+
+	std::size_t Size() const { return commands_.size(); }
+	bool Empty() const { return commands_.empty(); }
+
+	// Orders commands by key (stable)
+	void Sort();
+	// Sorts, draws every command and clears the queue. GL thread only.
+	void Execute();
+	// Frees the shared vertex buffer; call before the context goes away
+	static void Shutdown();
+
+	// Command indices in draw order, valid after Sort
+	const std::vector<std::uint32_t>& GetOrder() const { return order_; }
+	const SpriteCommand& GetCommand(std::size_t i) const { return commands_[i]; }
+
+private:
+	struct SortEntry {
+		std::uint64_t key;
+		std::uint32_t index;
+	};
+
+	std::vector<SpriteCommand> commands_;
+	std::vector<SortEntry> keys_;
+	std::vector<SortEntry> scratch_;
+	std::vector<std::uint32_t> order_;
+	std::vector<RenderQueue> locals_;   // per-job queues of SubmitParallel
+};
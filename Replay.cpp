@@ -0,0 +1,193 @@
+// Replay.cpp
+#include "Replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Log.h"
+
+namespace {
+    constexpr char Magic[4] = { 'C', 'C', 'R', 'P' };
+    constexpr std::uint16_t Version = 3;
+    constexpr std::uint16_t FirstContinuedVersion = 2;
+    constexpr std::uint16_t PressedBit = 0x8000;
+    constexpr std::uint16_t SilentBit = 0x4000;
+    constexpr std::uint16_t LevelLoadEvent = 0x7FFF;
+    constexpr std::size_t HeaderSize = 4 + 2 + 4 + 4 + 4;
+    // A full count byte means the tick continues in another record
+    constexpr std::size_t MaxEventsPerRecord = 255;
+
+    void PutU16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+        out.push_back(static_cast<std::uint8_t>(v & 0xFF));
+        out.push_back(static_cast<std::uint8_t>(v >> 8));
+    }
+
+    void PutU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<std::uint8_t>((v >> (8 * i)) & 0xFF));
+    }
+
+    std::uint16_t GetU16(const std::uint8_t* p) {
+        return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    std::uint32_t GetU32(const std::uint8_t* p) {
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+               (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+}
+
+bool ReplayRecorder::Begin(const std::string& path, std::uint32_t seed, float tickStep) {
+    path_ = path;
+    seed_ = seed;
+    tickStep_ = tickStep;
+    tickCount_ = 0;
+    pending_.clear();
+    data_.clear();
+    data_.reserve(64 * 1024);
+    recordedDown_.fill(false);
+    heldDown_.fill(false);
+    heldKeys_.clear();
+    recording_ = true;
+    LOG_INFO("⏺️ Recording input to %s (seed %u)", path_.c_str(), seed_);
+    return true;
+}
+
+void ReplayRecorder::HoldEvents(const std::vector<InputEvent>& events) {
+    if (!recording_) return;
+    for (const InputEvent& event : events) {
+        if (event.key >= KeyCount) continue;
+        if (std::find(heldKeys_.begin(), heldKeys_.end(), event.key) == heldKeys_.end())
+            heldKeys_.push_back(event.key);
+        heldDown_[event.key] = event.pressed;
+    }
+}
+
+void ReplayRecorder::RecordTick(const std::vector<InputEvent>& events) {
+    if (!recording_) return;
+
+    // Net changes over the pause first, then the tick's own events
+    for (std::uint16_t key : heldKeys_) {
+        if (heldDown_[key] == recordedDown_[key]) continue;
+        recordedDown_[key] = heldDown_[key];
+        pending_.push_back(static_cast<std::uint16_t>(key | SilentBit | (heldDown_[key] ? PressedBit : 0)));
+    }
+    heldKeys_.clear();
+    for (const InputEvent& event : events) {
+        if (event.key >= KeyCount) continue;
+        recordedDown_[event.key] = heldDown_[event.key] = event.pressed;
+        pending_.push_back(static_cast<std::uint16_t>(event.key | (event.pressed ? PressedBit : 0)));
+    }
+
+    // The count is a single byte: bigger ticks are split into full records
+    // followed by a short (possibly empty) one
+    std::size_t written = 0;
+    for (;;) {
+        std::size_t count = std::min(pending_.size() - written, MaxEventsPerRecord);
+        data_.push_back(static_cast<std::uint8_t>(count));
+        for (std::size_t i = 0; i < count; ++i)
+            PutU16(data_, pending_[written + i]);
+        written += count;
+        if (count < MaxEventsPerRecord) break;
+    }
+    pending_.clear();
+    ++tickCount_;
+}
+
+void ReplayRecorder::RecordLevelLoad(int index) {
+    if (!recording_) return;
+    pending_.push_back(LevelLoadEvent);
+    pending_.push_back(static_cast<std::uint16_t>(static_cast<std::int16_t>(index)));
+}
+
+bool ReplayRecorder::End() {
+    if (!recording_) return true;
+    recording_ = false;
+
+    std::vector<std::uint8_t> header;
+    header.insert(header.end(), std::begin(Magic), std::end(Magic));
+    PutU16(header, Version);
+    PutU32(header, seed_);
+    std::uint32_t stepBits;
+    std::memcpy(&stepBits, &tickStep_, sizeof(stepBits));
+    PutU32(header, stepBits);
+    PutU32(header, tickCount_);
+
+    std::ofstream file(path_, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("❌ Failed to write replay %s", path_.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(data_.data()), static_cast<std::streamsize>(data_.size()));
+    LOG_INFO("⏹️ Wrote %u ticks (%zu bytes) to %s", tickCount_, header.size() + data_.size(), path_.c_str());
+    return static_cast<bool>(file);
+}
+
+bool ReplayPlayer::Load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("❌ Failed to open replay %s", path.c_str());
+        return false;
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < HeaderSize || std::memcmp(bytes.data(), Magic, sizeof(Magic)) != 0) {
+        LOG_ERROR("❌ %s is not a replay file", path.c_str());
+        return false;
+    }
+    version_ = GetU16(bytes.data() + 4);
+    if (version_ == 0 || version_ > Version) {
+        LOG_ERROR("❌ Unsupported replay version in %s", path.c_str());
+        return false;
+    }
+
+    seed_ = GetU32(bytes.data() + 6);
+    std::uint32_t stepBits = GetU32(bytes.data() + 10);
+    std::memcpy(&tickStep_, &stepBits, sizeof(tickStep_));
+    tickCount_ = GetU32(bytes.data() + 14);
+
+    data_.assign(bytes.begin() + HeaderSize, bytes.end());
+    tick_ = 0;
+    cursor_ = 0;
+    LOG_INFO("▶️ Loaded replay %s: %u ticks, seed %u", path.c_str(), tickCount_, seed_);
+    return true;
+}
+
+bool ReplayPlayer::NextTick(std::vector<InputEvent>& events, int& levelLoad) {
+    events.clear();
+    levelLoad = -1;
+    if (IsFinished() || cursor_ >= data_.size()) {
+        tick_ = tickCount_;
+        return false;
+    }
+
+    // Version 1 files capped a tick at one record
+    words_.clear();
+    for (;;) {
+        std::size_t count = data_[cursor_++];
+        for (std::size_t i = 0; i < count && cursor_ + 2 <= data_.size(); ++i) {
+            words_.push_back(GetU16(&data_[cursor_]));
+            cursor_ += 2;
+        }
+        if (count < MaxEventsPerRecord || version_ < FirstContinuedVersion || cursor_ >= data_.size())
+            break;
+    }
+
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+        std::uint16_t event = words_[i];
+        if (event == LevelLoadEvent && i + 1 < words_.size()) {
+            levelLoad = static_cast<std::int16_t>(words_[++i]);
+            continue;
+        }
+
+        auto key = static_cast<std::uint16_t>(event & ~(PressedBit | SilentBit));
+        if (key < KeyCount)
+            events.push_back({ 0.0, key, (event & PressedBit) != 0, (event & SilentBit) != 0 });
+    }
+
+    ++tick_;
+    return true;
+}
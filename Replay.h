@@ -0,0 +1,80 @@
+// Replay.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Input.h"
+
+// Input replay file (.ccr), all little-endian:
+//   header: "CCRP" | u16 version | u32 seed | f32 tick step | u32 tick count
+//   ticks:  u8 event count, then that many u16 events; since version 2 a
+//           count of 255 continues the tick with another count and events
+//     bit 15 = key pressed, bits 0..13 = key code (< KeyCount)
+//     bit 14 (version 3) = silent: the key's net change over a pause
+//     LevelLoadEvent is followed by an i16 level index
+// Key events are stored in the order the tick applied them (a tap inside
+// one tick is a press and a release), so an idle tick costs one byte.
+
+class ReplayRecorder {
+public:
+	static constexpr int KeyCount = 1024;
+
+	bool Begin(const std::string& path, std::uint32_t seed, float tickStep);
+	// Call once per simulated tick with the key events the tick applied
+	void RecordTick(const std::vector<InputEvent>& events);
+	// Events applied while the simulation didn't run (paused). The live
+	// game drops their edges, so only each key's net change is written,
+	// as silent events ahead of the next recorded tick; a press released
+	// again during the pause leaves nothing.
+	void HoldEvents(const std::vector<InputEvent>& events);
+	// A level load triggered from outside the simulation (e.g. the pause menu);
+	// replayed before the next recorded tick
+	void RecordLevelLoad(int index);
+	// Writes the file; returns false on I/O failure
+	bool End();
+
+	bool IsRecording() const { return recording_; }
+
+private:
+	bool recording_ = false;
+	std::string path_;
+	std::uint32_t seed_ = 0;
+	float tickStep_ = 0.0f;
+	std::uint32_t tickCount_ = 0;
+	std::vector<std::uint16_t> pending_;   // events for the next tick
+	std::vector<std::uint8_t> data_;       // encoded ticks
+	// Key state as of the last recorded tick, and including held events
+	std::array<bool, KeyCount> recordedDown_{};
+	std::array<bool, KeyCount> heldDown_{};
+	std::vector<std::uint16_t> heldKeys_;  // keys held events touched
+};
+
+class ReplayPlayer {
+public:
+	static constexpr int KeyCount = ReplayRecorder::KeyCount;
+
+	bool Load(const std::string& path);
+
+	std::uint32_t GetSeed() const { return seed_; }
+	float GetTickStep() const { return tickStep_; }
+	std::uint32_t GetTickCount() const { return tickCount_; }
+	bool IsFinished() const { return tick_ >= tickCount_; }
+
+	// The next tick's key events, in order. levelLoad is set to the level
+	// to load before simulating the tick, or -1. Returns false once the
+	// recording is exhausted.
+	bool NextTick(std::vector<InputEvent>& events, int& levelLoad);
+
+private:
+	std::uint32_t seed_ = 0;
+	float tickStep_ = 0.0f;
+	std::uint32_t tickCount_ = 0;
+	std::uint32_t tick_ = 0;
+	std::size_t cursor_ = 0;
+	std::uint16_t version_ = 0;
+	std::vector<std::uint8_t> data_;
+	std::vector<std::uint16_t> words_;   // one tick's events, continuations joined
+};
@@ -11,9 +11,12 @@
 #include <iostream>
 #include <glad/glad.h>
 
+#include "FrameUniforms.h"
+#include "GLState.h"
+
 Shader &Shader::Use()
 {
-    glUseProgram(this->ID);
+    GLState::UseProgram(this->ID);
     return *this;
 }
 
@@ -46,6 +49,10 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
         glAttachShader(this->ID, gShader);
     glLinkProgram(this->ID);
     checkCompileErrors(this->ID, "PROGRAM");
+    // GLSL 330 has no layout(binding); tie the per-frame block up here
+    unsigned int frameBlock = glGetUniformBlockIndex(this->ID, "Frame");
+    if (frameBlock != GL_INVALID_INDEX)
+        glUniformBlockBinding(this->ID, frameBlock, FrameUniforms::BindingPoint);
     // delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(sVertex);
     glDeleteShader(sFragment);
@@ -0,0 +1,154 @@
+// Stats.cpp
+#include "Stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <glad/glad.h>
+
+namespace {
+    // Timer queries are read back a few frames after they were issued so
+    // we never stall the pipeline waiting on the GPU.
+    constexpr std::size_t GpuFramesInFlight = 3;
+
+    GLuint gpuQueries[GpuFramesInFlight][Stats::PhaseCount] = {};
+    bool gpuIssued[GpuFramesInFlight][Stats::PhaseCount] = {};
+    bool gpuInitialized = false;
+    std::size_t gpuFrame = 0;
+    std::array<float, Stats::PhaseCount> gpuLatestMs{};
+
+    const char* counterNames[] = { "Draw calls", "State changes", "State skipped", "Tiles drawn", "Enemies", "Enemies awake" };
+    const char* phaseNames[] = { "Input", "Update", "Render", "UI", "Pacing" };
+
+    static_assert(std::size(counterNames) == Stats::CounterCount);
+    static_assert(std::size(phaseNames) == Stats::PhaseCount);
+}
+
+void Stats::BeginFrame() {
+    current_ = FrameStats{};
+
+    if (gpuInitialized) {
+        gpuFrame = (gpuFrame + 1) % GpuFramesInFlight;
+
+        // The slot we are about to reuse was issued GpuFramesInFlight frames ago
+        for (std::size_t p = 0; p < PhaseCount; ++p) {
+            if (!gpuIssued[gpuFrame][p]) continue;
+
+            GLint available = 0;
+            glGetQueryObjectiv(gpuQueries[gpuFrame][p], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(gpuQueries[gpuFrame][p], GL_QUERY_RESULT, &ns);
+                gpuLatestMs[p] = static_cast<float>(ns) / 1.0e6f;
+            }
+            gpuIssued[gpuFrame][p] = false;
+        }
+    }
+
+    current_.gpuMs = gpuLatestMs;
+}
+
+void Stats::EndFrame(float frameMs) {
+    current_.frameMs = frameMs;
+    last_ = current_;
+
+    history_[historyHead_] = frameMs;
+    historyHead_ = (historyHead_ + 1) % HistorySize;
+    historyCount_ = std::min(historyCount_ + 1, HistorySize);
+}
+
+void Stats::BeginGpu(StatPhase phase) {
+    if (!gpuInitialized) {
+        glGenQueries(static_cast<GLsizei>(GpuFramesInFlight * PhaseCount), &gpuQueries[0][0]);
+        gpuInitialized = true;
+    }
+    auto p = static_cast<std::size_t>(phase);
+    // A still-pending query can't be restarted; skip this sample instead
+    if (gpuIssued[gpuFrame][p]) return;
+    glBeginQuery(GL_TIME_ELAPSED, gpuQueries[gpuFrame][p]);
+}
+
+void Stats::EndGpu(StatPhase phase) {
+    auto p = static_cast<std::size_t>(phase);
+    if (!gpuInitialized || gpuIssued[gpuFrame][p]) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuIssued[gpuFrame][p] = true;
+}
+
+void Stats::RecordLevelLoad(int index, float ms) {
+    // Keep the most recent loads, newest last
+    if (levelLoadCount_ == LevelLoadHistorySize) {
+        std::rotate(levelLoads_.begin(), levelLoads_.begin() + 1, levelLoads_.end());
+        --levelLoadCount_;
+    }
+    levelLoads_[levelLoadCount_++] = { index, ms };
+}
+
+float Stats::FrameHistoryAt(std::size_t i) {
+    std::size_t oldest = (historyHead_ + HistorySize - historyCount_) % HistorySize;
+    return history_[(oldest + i) % HistorySize];
+}
+
+float Stats::FrameHistoryMax() {
+    float maxMs = 0.0f;
+    for (std::size_t i = 0; i < historyCount_; ++i)
+        maxMs = std::max(maxMs, FrameHistoryAt(i));
+    return maxMs;
+}
+
+float Stats::FrameHistoryAverage() {
+    if (historyCount_ == 0) return 0.0f;
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < historyCount_; ++i)
+        sum += FrameHistoryAt(i);
+    return sum / static_cast<float>(historyCount_);
+}
+
+float Stats::FrameHistoryStdDev() {
+    if (historyCount_ == 0) return 0.0f;
+    float avg = FrameHistoryAverage();
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < historyCount_; ++i) {
+        float d = FrameHistoryAt(i) - avg;
+        sum += d * d;
+    }
+    return std::sqrt(sum / static_cast<float>(historyCount_));
+}
+
+const char* Stats::Name(StatCounter counter) {
+    return counterNames[static_cast<std::size_t>(counter)];
+}
+
+const char* Stats::Name(StatPhase phase) {
+    return phaseNames[static_cast<std::size_t>(phase)];
+}
+
+FrameTimeSeries::Summary FrameTimeSeries::Summarize() const {
+    Summary summary;
+    summary.count = samples_.size();
+    if (samples_.empty()) return summary;
+
+    std::vector<float> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (float ms : sorted) sum += ms;
+    double mean = sum / static_cast<double>(sorted.size());
+
+    double variance = 0.0;
+    for (float ms : sorted) variance += (ms - mean) * (ms - mean);
+    variance /= static_cast<double>(sorted.size());
+
+    auto percentile = [&](float p) {
+        std::size_t i = static_cast<std::size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+        return sorted[std::min(i, sorted.size() - 1)];
+    };
+
+    summary.avgMs = static_cast<float>(mean);
+    summary.minMs = sorted.front();
+    summary.maxMs = sorted.back();
+    summary.p50Ms = percentile(0.50f);
+    summary.p95Ms = percentile(0.95f);
+    summary.p99Ms = percentile(0.99f);
+    summary.stdDevMs = static_cast<float>(std::sqrt(variance));
+    return summary;
+}
@@ -0,0 +1,150 @@
+// Stats.h
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-frame counters. Draw sites and systems bump these during a frame;
+// readers (the perf overlay) look at the previous, completed frame.
+enum class StatCounter {
+	DrawCalls,
+	StateChanges,
+	StateSkipped,
+	TilesDrawn,
+	Enemies,
+	EnemiesAwake,
+	Count
+};
+
+// Timed phases of a frame. Every phase gets a CPU time; phases bracketed
+// with a GPU query also get a GPU time.
+enum class StatPhase {
+	Input,
+	Update,
+	Render,
+	UI,
+	Pacing,   // frame pacing waits and the swap
+	Count
+};
+
+constexpr std::size_t StatCounterCount = static_cast<std::size_t>(StatCounter::Count);
+constexpr std::size_t StatPhaseCount = static_cast<std::size_t>(StatPhase::Count);
+
+// Everything recorded for one frame
+struct StatFrame {
+	std::array<std::uint64_t, StatCounterCount> counters{};
+	std::array<float, StatPhaseCount> cpuMs{};
+	std::array<float, StatPhaseCount> gpuMs{};
+	float frameMs = 0.0f;
+};
+
+struct StatLevelLoad {
+	int index = -1;
+	float ms = 0.0f;
+};
+
+// A static registry for frame statistics, in the same spirit as
+// ResourceManager: no instances, everything reachable from anywhere.
+// Counters are plain array slots so bumping one on a hot path is a single add.
+class Stats {
+public:
+	static constexpr std::size_t CounterCount = StatCounterCount;
+	static constexpr std::size_t PhaseCount = StatPhaseCount;
+	static constexpr std::size_t HistorySize = 240;      // frame-time samples kept for graphs
+	static constexpr std::size_t LevelLoadHistorySize = 8;
+
+	using FrameStats = StatFrame;
+	using LevelLoad = StatLevelLoad;
+
+	// Frame boundaries: BeginFrame resets counters and collects finished GPU
+	// queries, EndFrame publishes the frame and pushes its time into history.
+	static void BeginFrame();
+	static void EndFrame(float frameMs);
+
+	static void Add(StatCounter counter, std::uint64_t amount = 1) {
+		current_.counters[static_cast<std::size_t>(counter)] += amount;
+	}
+	static void Set(StatCounter counter, std::uint64_t value) {
+		current_.counters[static_cast<std::size_t>(counter)] = value;
+	}
+	static void RecordCpu(StatPhase phase, float ms) {
+		current_.cpuMs[static_cast<std::size_t>(phase)] += ms;
+	}
+
+	// GPU timings use GL_TIME_ELAPSED queries which can't nest, so only
+	// bracket non-overlapping phases. Results arrive a few frames late.
+	static void BeginGpu(StatPhase phase);
+	static void EndGpu(StatPhase phase);
+
+	static void RecordLevelLoad(int index, float ms);
+
+	static const FrameStats& LastFrame() { return last_; }
+	// Frame time history, oldest first; i in [0, HistoryCount())
+	static float FrameHistoryAt(std::size_t i);
+	static std::size_t HistoryCount() { return historyCount_; }
+	static float FrameHistoryMax();
+	static float FrameHistoryAverage();
+	static float FrameHistoryStdDev();
+
+	static const std::array<LevelLoad, LevelLoadHistorySize>& LevelLoads() { return levelLoads_; }
+	static std::size_t LevelLoadCount() { return levelLoadCount_; }
+
+	static const char* Name(StatCounter counter);
+	static const char* Name(StatPhase phase);
+
+private:
+	Stats() { }
+
+	static inline FrameStats current_{};
+	static inline FrameStats last_{};
+	static inline std::array<float, HistorySize> history_{};
+	static inline std::size_t historyHead_ = 0;
+	static inline std::size_t historyCount_ = 0;
+	static inline std::array<LevelLoad, LevelLoadHistorySize> levelLoads_{};
+	static inline std::size_t levelLoadCount_ = 0;
+};
+
+// Adds the lifetime of the scope to a phase's CPU time, and optionally
+// brackets it with a GPU timer query.
+class ScopedPhaseTimer {
+public:
+	explicit ScopedPhaseTimer(StatPhase phase, bool gpu = false)
+		: phase_(phase), gpu_(gpu), start_(std::chrono::steady_clock::now()) {
+		if (gpu_) Stats::BeginGpu(phase_);
+	}
+	~ScopedPhaseTimer() {
+		if (gpu_) Stats::EndGpu(phase_);
+		std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start_;
+		Stats::RecordCpu(phase_, elapsed.count());
+	}
+	ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+	ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+	StatPhase phase_;
+	bool gpu_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+// Collects per-frame (or per-tick) times for an end-of-run summary, e.g.
+// replay playback. Reserve up front to keep Add() allocation-free.
+class FrameTimeSeries {
+public:
+	struct Summary {
+		std::size_t count = 0;
+		float avgMs = 0.0f, minMs = 0.0f, maxMs = 0.0f;
+		float p50Ms = 0.0f, p95Ms = 0.0f, p99Ms = 0.0f;
+		float stdDevMs = 0.0f;
+	};
+
+	void Reserve(std::size_t count) { samples_.reserve(count); }
+	void Add(float ms) { samples_.push_back(ms); }
+	void Clear() { samples_.clear(); }
+	Summary Summarize() const;
+
+private:
+	std::vector<float> samples_;
+};
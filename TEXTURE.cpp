@@ -10,6 +10,7 @@
 #include <GL/gl.h>
 
 #include "texture.h"
+#include "GLState.h"
 
 
 Texture2D::Texture2D()
@@ -27,7 +28,7 @@ void Texture2D::Generate(unsigned int width, unsigned int height,
 	Width  = width;
 	Height = height;
 
-	glBindTexture(GL_TEXTURE_2D, ID);
+	GLState::BindTexture(ID);
 
 	// ALWAYS use tight packing so any image width is safe.
 	GLint prevAlign;
@@ -46,11 +47,9 @@ void Texture2D::Generate(unsigned int width, unsigned int height,
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, Wrap_T);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Texture2D::Bind() const
 {
-	glBindTexture(GL_TEXTURE_2D, this->ID);
+	GLState::BindTexture(this->ID);
 }
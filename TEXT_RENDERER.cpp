@@ -9,6 +9,8 @@
 
 #include "text_renderer.h"
 #include "resource_manager.h"
+#include "GLState.h"
+#include "Stats.h"
 
 
 TextRenderer::TextRenderer(unsigned int width, unsigned int height)
@@ -19,13 +21,13 @@ TextRenderer::TextRenderer(unsigned int width, unsigned int height)
     // configure VAO/VBO for texture quads
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
-    glBindVertexArray(this->VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    GLState::BindVertexArray(this->VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindVertexArray(0);
 }
 
 void TextRenderer::Load(std::string font, unsigned int fontSize)
@@ -56,7 +58,7 @@ void TextRenderer::Load(std::string font, unsigned int fontSize)
         // generate texture
         unsigned int texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        GLState::BindTexture(texture);
         glTexImage2D(
             GL_TEXTURE_2D,
             0,
@@ -87,20 +89,19 @@ void TextRenderer::Load(std::string font, unsigned int fontSize)
     this->FontSize = fontSize;
     this->Ascent = face->size->metrics.ascender >> 6;
     this->Descent = face->size->metrics.descender >> 6;
-    glBindTexture(GL_TEXTURE_2D, 0);
     // destroy FreeType once we're finished
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
 }
 
-void TextRenderer::RenderText(std::string text, float x, float y, float scale, glm::vec3 color, const glm::mat4& projection)
+void TextRenderer::RenderText(std::string text, float x, float y, float scale, glm::vec3 color, bool worldSpace)
 {
     // activate corresponding render state
     this->TextShader->Use();
-    this->TextShader->SetMatrix4("projection", projection); // ✅ Set here instead
+    this->TextShader->SetInteger("worldSpace", worldSpace ? 1 : 0);
     this->TextShader->SetVector3f("textColor", color);
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(this->VAO);
+    GLState::BindVertexArray(this->VAO);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, this->VBO);
 
     // iterate through all characters
     std::string::const_iterator c;
@@ -124,18 +125,15 @@ void TextRenderer::RenderText(std::string text, float x, float y, float scale, g
             { xpos + w, ypos,       1.0f, 0.0f }
         };
         // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+        GLState::BindTexture(ch.TextureID);
         // update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); // be sure to use glBufferSubData and not glBufferData
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
         // render quad
         glDrawArrays(GL_TRIANGLES, 0, 6);
+        Stats::Add(StatCounter::DrawCalls);
         // now advance cursors for next glyph
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (1/64th times 2^6 = 64)
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 float TextRenderer::MeasureTextWidth(const std::string& text, float scale) {
@@ -147,6 +145,13 @@ float TextRenderer::MeasureTextWidth(const std::string& text, float scale) {
     }
     return width;
 }
+std::size_t TextRenderer::GetTextureMemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& [_, ch] : Characters)
+        bytes += static_cast<std::size_t>(ch.Size.x) * ch.Size.y;
+    return bytes;
+}
+
 glm::vec4 TextRenderer::MeasureRenderedTextBounds(const std::string& text, float x, float y, float scale) const // Add const
 {
     // ... existing implementation ...
@@ -43,8 +43,9 @@ public:
 	TextRenderer(unsigned int width, unsigned int height);
 	// pre-compiles a list of characters from the given font
 	void Load(std::string font, unsigned int fontSize);
-	// renders a string of text using the precompiled list of characters
-	void RenderText(std::string text, float x, float y, float scale, glm::vec3 color, const glm::mat4& projection);
+	// renders a string of text using the precompiled list of characters, in
+	// framebuffer pixels or (worldSpace) through the level's view-projection
+	void RenderText(std::string text, float x, float y, float scale, glm::vec3 color, bool worldSpace = false);
 
 	glm::vec4 MeasureRenderedTextBounds(const std::string& text, float x, float y, float scale) const;
 	static TextRenderer& LoadTextRenderer(const std::string& name, unsigned int width, unsigned int height);
@@ -54,6 +55,9 @@ public:
 		return (Ascent - Descent) * scale;
 	}
     unsigned int GetFontSize() const { return FontSize; }
+	// bytes held by the glyph textures (GL_RED, one byte per texel) and the quad VBO
+	std::size_t GetTextureMemoryUsage() const;
+	std::size_t GetBufferMemoryUsage() const { return sizeof(float) * 6 * 4; }
 	unsigned int FontSize;
 private:
 	// render state
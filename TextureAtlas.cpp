@@ -0,0 +1,98 @@
+// TextureAtlas.cpp
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+    int NextPowerOfTwo(int v) {
+        int p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+}
+
+TextureAtlasBuilder::TextureAtlasBuilder(int maxSize, int padding)
+    : maxSize_(maxSize), padding_(std::max(0, padding)) {}
+
+bool TextureAtlasBuilder::Pack(const std::vector<AtlasImage>& images) {
+    pages_.clear();
+    placements_.assign(images.size(), Placement{});
+    if (images.empty()) return true;
+
+    // Page width: roughly square for the total area, never narrower than
+    // the widest image
+    long long area = 0;
+    int widest = 0;
+    for (const auto& img : images) {
+        int w = img.width + 2 * padding_, h = img.height + 2 * padding_;
+        if (w > maxSize_ || h > maxSize_) return false;
+        area += static_cast<long long>(w) * h;
+        widest = std::max(widest, w);
+    }
+    int pageWidth = std::min(maxSize_, NextPowerOfTwo(std::max(widest, static_cast<int>(std::sqrt(static_cast<double>(area))))));
+
+    // Tallest first keeps the shelves tight
+    std::vector<std::size_t> order(images.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return images[a].height > images[b].height;
+    });
+
+    int page = -1, cursorX = 0, shelfY = 0, shelfHeight = 0;
+    for (std::size_t i : order) {
+        int w = images[i].width + 2 * padding_, h = images[i].height + 2 * padding_;
+
+        if (page >= 0 && cursorX + w > pageWidth) {
+            // Next shelf
+            shelfY += shelfHeight;
+            cursorX = 0;
+            shelfHeight = 0;
+        }
+        if (page < 0 || shelfY + h > maxSize_) {
+            // Next page
+            pages_.push_back({ pageWidth, 0 });
+            page = static_cast<int>(pages_.size()) - 1;
+            cursorX = shelfY = shelfHeight = 0;
+        }
+
+        placements_[i] = { page, cursorX + padding_, shelfY + padding_, images[i].width, images[i].height };
+        cursorX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        pages_[page].y = std::max(pages_[page].y, shelfY + h);
+    }
+    return true;
+}
+
+glm::vec4 TextureAtlasBuilder::GetRegion(std::size_t image) const {
+    const Placement& p = placements_[image];
+    glm::vec2 size = glm::vec2(pages_[p.page]);
+    return { p.x / size.x, p.y / size.y, p.width / size.x, p.height / size.y };
+}
+
+std::vector<unsigned char> TextureAtlasBuilder::Compose(int page, const std::vector<AtlasImage>& images) const {
+    const glm::ivec2 size = pages_[page];
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(size.x) * size.y * 4, 0);
+
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        const Placement& p = placements_[i];
+        if (p.page != page) continue;
+        const AtlasImage& img = images[i];
+
+        // Copy with the edge rows/columns extruded into the padding
+        for (int y = -padding_; y < img.height + padding_; ++y) {
+            int srcY = std::clamp(y, 0, img.height - 1);
+            unsigned char* dst = &pixels[(static_cast<std::size_t>(p.y + y) * size.x + (p.x - padding_)) * 4];
+            const unsigned char* row = img.pixels + static_cast<std::size_t>(srcY) * img.width * 4;
+            for (int x = -padding_; x < 0; ++x, dst += 4)
+                std::memcpy(dst, row, 4);
+            std::memcpy(dst, row, static_cast<std::size_t>(img.width) * 4);
+            dst += static_cast<std::size_t>(img.width) * 4;
+            for (int x = 0; x < padding_; ++x, dst += 4)
+                std::memcpy(dst, row + (img.width - 1) * 4, 4);
+        }
+    }
+    return pixels;
+}
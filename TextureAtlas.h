@@ -0,0 +1,54 @@
+// TextureAtlas.h
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// One RGBA8 source image; pixels are row-major, top row first
+struct AtlasImage {
+	int width = 0, height = 0;
+	const unsigned char* pixels = nullptr;
+};
+
+// Shelf packer for sprite sheets and tilesets. Images go onto as few
+// pages as fit under maxSize, tallest first, each surrounded by `padding`
+// pixels of its own edge colour so nearest sampling at a frame border
+// never picks up a neighbouring sheet. CPU only; the caller uploads pages.
+class TextureAtlasBuilder {
+public:
+	explicit TextureAtlasBuilder(int maxSize, int padding = 1);
+
+	// False if an image is larger than a page
+	bool Pack(const std::vector<AtlasImage>& images);
+
+	int GetPageCount() const { return static_cast<int>(pages_.size()); }
+	glm::ivec2 GetPageSize(int page) const { return pages_[page]; }
+	int GetPage(std::size_t image) const { return placements_[image].page; }
+
+	// Where image sits in its page: uv offset (xy) and scale (zw). A sprite's
+	// own uvRect maps into the page with RemapUV.
+	glm::vec4 GetRegion(std::size_t image) const;
+
+	// Page pixels (RGBA8, top row first) with every image and its padding
+	std::vector<unsigned char> Compose(int page, const std::vector<AtlasImage>& images) const;
+
+private:
+	struct Placement {
+		int page = -1;
+		int x = 0, y = 0;   // top-left of the image itself, inside the padding
+		int width = 0, height = 0;
+	};
+
+	int maxSize_;
+	int padding_;
+	std::vector<glm::ivec2> pages_;
+	std::vector<Placement> placements_;
+};
+
+// Maps a uvRect (offset.xy, size.zw) in a sheet's own 0..1 space into the
+// atlas region the sheet was packed into
+inline glm::vec4 RemapUV(const glm::vec4& region, const glm::vec4& uvRect) {
+	return { region.x + uvRect.x * region.z, region.y + uvRect.y * region.w,
+			 uvRect.z * region.z, uvRect.w * region.w };
+}
@@ -1,6 +1,8 @@
 #include "TileMap.h"
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 
@@ -8,8 +10,9 @@
 #include "Collision.h"
 #include "Dog.h"
 #include "RESOURCE_MANAGER.h"
-
-unsigned int TileMap::quadVAO_ = 0;
+#include "GLState.h"
+#include "Stats.h"
+#include "TextureAtlas.h"
 
 TileMap::TileMap(std::shared_ptr<Shader> shader, std::shared_ptr<Texture2D> tileset,
                  int textureWidth, int textureHeight,
@@ -19,9 +22,6 @@ TileMap::TileMap(std::shared_ptr<Shader> shader, std::shared_ptr<Texture2D> tile
 {
     tilesPerRow_ = textureWidth / tileWidth_;
     tilesPerCol_ = textureHeight / tileHeight_;
-
-    if (quadVAO_ == 0)
-        initRenderData();
 }
 
 
@@ -29,73 +29,73 @@ void TileMap::Load(const std::vector<std::vector<int>>& mapData) {
     mapData_ = mapData;
 }
 
-void TileMap::Draw(const glm::mat4& projection)
-{
-    shader_->Use();
-    shader_->SetMatrix4("projection", projection);
-    tileset_->Bind();
-    glBindVertexArray(quadVAO_);
+void TileMap::SetTile(int x, int y, int tileID) {
+    if (y < 0 || y >= static_cast<int>(mapData_.size()) ||
+        x < 0 || x >= static_cast<int>(mapData_[y].size())) return;
+    mapData_[y][x] = tileID;
+}
 
+void TileMap::Submit(RenderQueue& queue, std::uint8_t layer, const ViewRect* visible) const
+{
     int mapCols = mapData_[0].size();
     int mapRows = mapData_.size();
 
-    glm::vec2 uvSize(1.0f / tilesPerRow_, 1.0f / tilesPerCol_);
-
-    for (int y = 0; y < mapRows; ++y) {
-        for (int x = 0; x < mapCols; ++x) {
-            int tileID = mapData_[y][x];
-            if (tileID < 0) continue;
-
-            int tu = tileID % tilesPerRow_;
-            int tv = tilesPerCol_ - 1 - (tileID / tilesPerRow_);
-
-            glm::vec2 uvOffset(tu * uvSize.x, 1.0f - (tv + 1) * uvSize.y);
-
-            glm::vec3 pos(x * tileWidth_, y * tileHeight_, 0.0f);
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), pos);
-            model = glm::scale(model, glm::vec3(tileWidth_, tileHeight_, 1.0f));
-
-            shader_->SetMatrix4("model", model);
-            shader_->SetVector4f("uvRect", glm::vec4(uvOffset, uvSize));
-
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
+    // Tile range under the view, widened by one tile for partial overlaps
+    int x0 = 0, y0 = 0, x1 = mapCols, y1 = mapRows;
+    if (visible) {
+        x0 = std::max(0, static_cast<int>(std::floor(visible->min.x / tileWidth_)));
+        y0 = std::max(0, static_cast<int>(std::floor(visible->min.y / tileHeight_)));
+        x1 = std::min(mapCols, static_cast<int>(std::floor(visible->max.x / tileWidth_)) + 1);
+        y1 = std::min(mapRows, static_cast<int>(std::floor(visible->max.y / tileHeight_)) + 1);
     }
 
-    glBindVertexArray(0);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    SpriteCommand base;
+    base.shader = shader_.get();
+    base.texture = tileset_.get();
+    base.size = glm::vec2(tileWidth_, tileHeight_);
+    // Tiles of a layer never overlap, so they all share one key
+    const std::uint64_t key = RenderQueue::MakeKey(layer, base, 0);
+
+    // Bands of rows are built on the job system
+    std::size_t before = queue.Size();
+    queue.SubmitParallel(static_cast<std::size_t>(y1 - y0), SubmitRowsPerJob,
+        [&](std::size_t begin, std::size_t end, RenderQueue& out) {
+            SpriteCommand cmd = base;
+            for (int y = y0 + static_cast<int>(begin); y < y0 + static_cast<int>(end); ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    if (ComputeTileQuad(x, y, cmd.position, cmd.uvRect))
+                        out.Submit(key, cmd);
+                }
+            }
+        });
+    Stats::Add(StatCounter::TilesDrawn, queue.Size() - before);
 }
 
-void TileMap::initRenderData() const {
-    float vertices[] = {
-        0.0f, 1.0f,  0.0f, 1.0f,
-        1.0f, 0.0f,  1.0f, 0.0f,
-        0.0f, 0.0f,  0.0f, 0.0f,
-
-        0.0f, 1.0f,  0.0f, 1.0f,
-        1.0f, 1.0f,  1.0f, 1.0f,
-        1.0f, 0.0f,  1.0f, 0.0f
-    };
+bool TileMap::ComputeTileQuad(int x, int y, glm::vec2& position, glm::vec4& uvRect) const
+{
+    int tileID = mapData_[y][x];
+    if (tileID < 0) return false;
 
-    unsigned int VBO;
-    glGenVertexArrays(1, &quadVAO_);
-    glGenBuffers(1, &VBO);
+    glm::vec2 uvSize(1.0f / tilesPerRow_, 1.0f / tilesPerCol_);
 
-    glBindVertexArray(quadVAO_);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    int tu = tileID % tilesPerRow_;
+    int tv = tilesPerCol_ - 1 - (tileID / tilesPerRow_);
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glm::vec2 uvOffset(tu * uvSize.x, 1.0f - (tv + 1) * uvSize.y);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    position = glm::vec2(x * tileWidth_, y * tileHeight_);
+    uvRect = RemapUV(region_, glm::vec4(uvOffset, uvSize));
+    return true;
 }
 
-void TileMap::initGridLines() {
+
+void TileMap::initGridLines(int cols, int rows) {
     if (gridVAO_ != 0) {
         // Clear old buffer so new one can be rebuilt correctly
+        GLState::ForgetBuffer(gridVBO_);
+        GLState::ForgetVertexArray(gridVAO_);
         glDeleteBuffers(1, &gridVBO_);
         glDeleteVertexArrays(1, &gridVAO_);
         gridVBO_ = 0;
@@ -103,12 +103,6 @@ void TileMap::initGridLines() {
     }
 
     gridLines_.clear(); // 🧹 Important!
-    int rows = static_cast<int>(mapData_.size());
-    int cols = 0;
-
-    // Find the actual max width across all rows
-    for (const auto& row : mapData_)
-        cols = std::max(cols, static_cast<int>(row.size()));
 
     // Generate vertical grid lines
     for (int x = 0; x <= cols; ++x) {
@@ -128,65 +122,68 @@ void TileMap::initGridLines() {
     glGenVertexArrays(1, &gridVAO_);
     glGenBuffers(1, &gridVBO_);
 
-    glBindVertexArray(gridVAO_);
-    glBindBuffer(GL_ARRAY_BUFFER, gridVBO_);
+    GLState::BindVertexArray(gridVAO_);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, gridVBO_);
     glBufferData(GL_ARRAY_BUFFER, gridLines_.size() * sizeof(float), gridLines_.data(), GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLState::BindBuffer(GL_ARRAY_BUFFER, 0);
+    GLState::BindVertexArray(0);
 }
 
-void TileMap::DrawDebugGrid(const glm::mat4& projection,
-                             std::shared_ptr<Shader> debugShader,
-                             const std::unordered_set<int>& solidTiles,
-                             const std::vector<std::unique_ptr<TileMap>>& allLayers)
+void TileMap::CaptureDebugGrid(DebugTileGrid& grid, const std::unordered_set<int>& solidTiles,
+                               const std::vector<std::unique_ptr<TileMap>>& allLayers) const
 {
-    initGridLines();
+    grid.rows = static_cast<int>(mapData_.size());
+    grid.cols = 0;
+    // Find the actual max width across all rows
+    for (const auto& row : mapData_)
+        grid.cols = std::max(grid.cols, static_cast<int>(row.size()));
+    grid.solid.assign(static_cast<std::size_t>(grid.cols) * grid.rows, 0);
+
+    for (const auto& layer : allLayers) {
+        if (!layer->IsCollidable()) continue;
+
+        const auto& map = layer->GetMapData();
+        for (int y = 0; y < grid.rows && y < static_cast<int>(map.size()); ++y) {
+            for (int x = 0; x < grid.cols && x < static_cast<int>(map[y].size()); ++x) {
+                int tileID = map[y][x];
+                if (tileID >= 0 && solidTiles.find(tileID) != solidTiles.end())
+                    grid.solid[static_cast<std::size_t>(y) * grid.cols + x] = 1;
+            }
+        }
+    }
+}
+
+void TileMap::DrawDebugGrid(std::shared_ptr<Shader> debugShader, const DebugTileGrid& grid)
+{
+    if (grid.cols == 0 || grid.rows == 0) return;
+    initGridLines(grid.cols, grid.rows);
 
     if (debugShader) {
         debugShader->Use();
-        debugShader->SetMatrix4("projection", projection);
         debugShader->SetMatrix4("model", glm::mat4(1.0f));
         debugShader->SetVector3f("lineColor", glm::vec3(0.0f));
     }
 
-    glBindVertexArray(gridVAO_);
+    GLState::BindVertexArray(gridVAO_);
     glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(gridLines_.size() / 2));
-    glBindVertexArray(0);
+    Stats::Add(StatCounter::DrawCalls);
 
     if (!textRenderer_) return;
 
-    int rows = static_cast<int>(mapData_.size());
-    int cols = static_cast<int>(mapData_[0].size());
-
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-
-            bool isSolidInAnyLayer = false;
-
-            for (const auto& layer : allLayers) {
-                if (!layer->IsCollidable()) continue;
-
-                const auto& map = layer->GetMapData();
-                if (y < map.size() && x < map[y].size()) {
-                    int tileID = map[y][x];
-                    if (tileID >= 0 && solidTiles.find(tileID) != solidTiles.end()) {
-                        isSolidInAnyLayer = true;
-                        break;
-                    }
-                }
-            }
-
+    for (int y = 0; y < grid.rows; ++y) {
+        for (int x = 0; x < grid.cols; ++x) {
+            bool isSolidInAnyLayer = grid.solid[static_cast<std::size_t>(y) * grid.cols + x] != 0;
             glm::vec3 color = isSolidInAnyLayer ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(1.0f);
 
             std::string label = std::to_string(x) + "," + std::to_string(y);
             float xpos = x * tileWidth_ + 2.0f;
             float ypos = y * tileHeight_ + 12.0f;
 
-            textRenderer_->RenderText(label, xpos, ypos, 0.25f, color, projection);
+            textRenderer_->RenderText(label, xpos, ypos, 0.25f, color, true);
         }
     }
 }
@@ -198,10 +195,12 @@ void TileMap::SetTextRenderer(std::shared_ptr<TextRenderer> text) {
 
 void TileMap::Destroy() {
     if (gridVBO_) {
+        GLState::ForgetBuffer(gridVBO_);
         glDeleteBuffers(1, &gridVBO_);
         gridVBO_ = 0;
     }
     if (gridVAO_) {
+        GLState::ForgetVertexArray(gridVAO_);
         glDeleteVertexArrays(1, &gridVAO_);
         gridVAO_ = 0;
     }
@@ -8,6 +8,15 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "text_renderer.h"
+#include "Camera.h"
+#include "RenderQueue.h"
+
+// What the debug grid shows, copied out of the live tile data so it can be
+// drawn while the simulation edits tiles (SetTileBlocked)
+struct DebugTileGrid {
+	int cols = 0, rows = 0;
+	std::vector<std::uint8_t> solid;   // row-major; 1 = solid on a collidable layer
+};
 
 class TileMap {
 public:
@@ -18,18 +27,27 @@ public:
 
 
 	void Load(const std::vector<std::vector<int>>& mapData);
-	void Draw(const glm::mat4 & projection);
+	// Queues the tiles overlapping visible (all of them when null) on layer,
+	// building the commands on the job system
+	void Submit(RenderQueue& queue, std::uint8_t layer, const ViewRect* visible = nullptr) const;
+	// Top-left position and uvRect for the tile at (x, y); false for empty cells
+	bool ComputeTileQuad(int x, int y, glm::vec2& position, glm::vec4& uvRect) const;
 
 	int GetTileWidth() const { return tileWidth_; }
 	int GetTileHeight() const { return tileHeight_; }
 	const std::vector<std::vector<int>>& GetMapData() const { return mapData_; }
-	void DrawDebugGrid(const glm::mat4& projection,
-					   std::shared_ptr<Shader> debugShader,
-					   const std::unordered_set<int>& solidTiles,
-					   const std::vector<std::unique_ptr<TileMap>>& allLayers);
+	// Runtime edit of one cell; -1 empties it. Out-of-range cells are ignored.
+	void SetTile(int x, int y, int tileID);
+	// Fills grid from this layer's extent and the collidable layers' solid tiles
+	void CaptureDebugGrid(DebugTileGrid& grid, const std::unordered_set<int>& solidTiles,
+						  const std::vector<std::unique_ptr<TileMap>>& allLayers) const;
+	// Reads only grid, not the tile data
+	void DrawDebugGrid(std::shared_ptr<Shader> debugShader, const DebugTileGrid& grid);
 	void Destroy();
 
 	void SetTextRenderer(std::shared_ptr<TextRenderer> text);
+	// Where the tileset sits in its texture (an atlas page); whole texture by default
+	void SetTextureRegion(const glm::vec4& region) { region_ = region; }
 
 	void SetCollidable(bool c);
 	bool IsCollidable() const;
@@ -37,19 +55,18 @@ public:
 private:
 	std::shared_ptr<Shader> shader_;
 	std::shared_ptr<Texture2D> tileset_;
+	glm::vec4 region_{ 0.0f, 0.0f, 1.0f, 1.0f };
 	int textureWidth_{}, textureHeight_{};
 	int tileWidth_, tileHeight_;
 	std::vector<std::vector<int>> mapData_;
 	int tilesPerRow_, tilesPerCol_;
 	std::shared_ptr<TextRenderer> textRenderer_;
 	bool collidable = false;
+	static constexpr std::size_t SubmitRowsPerJob = 16;
 
 
 
-	static unsigned int quadVAO_;
-	void initRenderData() const;
-
-	void initGridLines();
+	void initGridLines(int cols, int rows);
 	mutable unsigned int gridVAO_ = 0;
 	mutable unsigned int gridVBO_ = 0;
 	mutable std::vector<float> gridLines_;
@@ -0,0 +1,368 @@
+// WorldStreamer.cpp
+#include "WorldStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <unordered_set>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Log.h"
+#include "Random.h"
+#include "Stats.h"
+
+using json = nlohmann::json;
+
+namespace {
+    std::future<json> ReadAsync(int index) {
+        return std::async(std::launch::async, [index] { return Level::ReadData(index); });
+    }
+
+    // Strict overlap; levels sharing an edge are fine
+    bool RectsOverlap(glm::vec2 aMin, glm::vec2 aSize, glm::vec2 bMin, glm::vec2 bSize) {
+        constexpr float Epsilon = 0.5f;
+        return aMin.x + aSize.x > bMin.x + Epsilon && bMin.x + bSize.x > aMin.x + Epsilon &&
+               aMin.y + aSize.y > bMin.y + Epsilon && bMin.y + bSize.y > aMin.y + Epsilon;
+    }
+}
+
+bool WorldStreamer::LoadConfig(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG_WARN("No world file %s; streaming stays off", path.c_str());
+        return false;
+    }
+    json data = json::parse(file, nullptr, false);
+    if (data.is_discarded()) {
+        LOG_ERROR("❌ %s is not valid JSON", path.c_str());
+        return false;
+    }
+
+    if (data.contains("streaming")) {
+        const auto& s = data["streaming"];
+        config_.enabled = s.value("enabled", config_.enabled);
+        config_.loadMargin = s.value("loadMargin", config_.loadMargin);
+        config_.unloadMargin = std::max(s.value("unloadMargin", config_.unloadMargin), config_.loadMargin);
+        config_.memoryBudget = static_cast<std::size_t>(s.value("memoryBudgetMB", 64.0) * 1024.0 * 1024.0);
+    }
+    LOG_INFO("🌍 World streaming %s", config_.enabled ? "on" : "off");
+    return true;
+}
+
+void WorldStreamer::Reset(int activeIndex) {
+    // Futures from std::async block in their destructor until the read is done
+    chunks_.clear();
+    retired_.clear();
+    tick_ = 0;
+    residentBytes_ = 0;
+    activeIndex_ = activeIndex;
+    activeOrigin_ = glm::vec2(0.0f);
+    activeSize_ = glm::vec2(0.0f);
+    ++revision_;
+}
+
+void WorldStreamer::Tick(Level& active) {
+    if (!config_.enabled) return;
+    ++tick_;
+    activeSize_ = active.GetMapSize();
+    Discover(active);
+
+    for (auto& [index, chunk] : chunks_)
+        if (chunk.pending.valid() && tick_ >= chunk.dueTick)
+            Resolve(index, chunk);
+
+    ChooseLoaded(active.GetCamera().GetVisibleRect());
+    UpdateCameraBounds(active);
+}
+
+void WorldStreamer::Update(Level& active, std::uint64_t gameSeed, unsigned int width, unsigned int height) {
+    if (!config_.enabled) return;
+
+    while (!retired_.empty()) {
+        std::unique_ptr<Level> level = std::move(retired_.back());
+        retired_.pop_back();
+        Free(std::move(level), active);
+    }
+
+    // One build per frame keeps the GL-side work to a small slice; the
+    // chosen chunk nearest the view goes first
+    const ViewRect& view = active.GetCamera().GetVisibleRect();
+    Chunk* nearest = nullptr;
+    int nearestIndex = -1;
+    float nearestDistance = 0.0f;
+    for (auto& [index, chunk] : chunks_) {
+        if (!chunk.wanted || chunk.level || chunk.buildFailed || chunk.data.is_null()) continue;
+        float distance = DistanceToView(chunk, view);
+        if (!nearest || distance < nearestDistance) {
+            nearest = &chunk;
+            nearestIndex = index;
+            nearestDistance = distance;
+        }
+    }
+    if (nearest)
+        Build(nearestIndex, *nearest, gameSeed, width, height);
+}
+
+void WorldStreamer::Discover(const Level& active) {
+    glm::ivec2 tile = active.GetTileSize();
+    glm::ivec2 tiles = glm::ivec2(activeSize_) / tile;
+
+    for (const auto& t : active.GetTransitions()) {
+        if (t.targetLevel == activeIndex_ || chunks_.count(t.targetLevel)) continue;
+
+        // Only transitions on the map edge link to a neighbour
+        glm::ivec2 side(0);
+        if (t.pos.y <= 0) side = { 0, -1 };
+        else if (t.pos.y + t.size.y >= tiles.y) side = { 0, 1 };
+        else if (t.pos.x <= 0) side = { -1, 0 };
+        else if (t.pos.x + t.size.x >= tiles.x) side = { 1, 0 };
+        else continue;
+
+        Chunk& chunk = chunks_[t.targetLevel];
+        chunk.parentOrigin = activeOrigin_;
+        chunk.parentSize = activeSize_;
+        chunk.side = side;
+        chunk.pending = ReadAsync(t.targetLevel);
+        chunk.dueTick = tick_ + ReadDueTicks;
+        chunk.state = ChunkState::Reading;
+    }
+}
+
+void WorldStreamer::Resolve(int index, Chunk& chunk) {
+    // May wait: the tick a read lands on must not depend on the disk
+    json data = chunk.pending.get();
+
+    if (chunk.state != ChunkState::Reading) {
+        // Re-read of a level the dog left, for rebuilding it later
+        if (!data.is_discarded())
+            chunk.data = std::move(data);
+        return;
+    }
+
+    chunk.data = std::move(data);
+    if (chunk.data.is_discarded() || !Place(index, chunk)) {
+        chunk.data = json();
+        chunk.state = ChunkState::Rejected;
+        return;
+    }
+    chunk.estimate = Level::EstimateMemoryUsage(chunk.data);
+    if (chunk.estimate > config_.memoryBudget) {
+        LOG_WARN("🌍 Level %d needs ~%zu KB, more than the whole streaming budget; it keeps a loading transition",
+                 index, chunk.estimate / 1024);
+        chunk.data = json();
+        chunk.state = ChunkState::Rejected;
+        return;
+    }
+    chunk.state = ChunkState::Placed;
+}
+
+bool WorldStreamer::Place(int index, Chunk& chunk) {
+    if (chunk.hasOrigin) return true;
+
+    // Next to the linking level along the shared edge, aligned at the top/left
+    chunk.size = Level::ComputeMapSize(chunk.data);
+    chunk.origin = chunk.parentOrigin;
+    if (chunk.side.x > 0) chunk.origin.x += chunk.parentSize.x;
+    if (chunk.side.x < 0) chunk.origin.x -= chunk.size.x;
+    if (chunk.side.y > 0) chunk.origin.y += chunk.parentSize.y;
+    if (chunk.side.y < 0) chunk.origin.y -= chunk.size.y;
+
+    bool overlaps = RectsOverlap(chunk.origin, chunk.size, activeOrigin_, activeSize_);
+    for (const auto& [other, c] : chunks_)
+        if (other != index && c.hasOrigin && RectsOverlap(chunk.origin, chunk.size, c.origin, c.size))
+            overlaps = true;
+    if (overlaps) {
+        LOG_INFO("🌍 Level %d overlaps the streamed world; it keeps a loading transition", index);
+        return false;
+    }
+
+    chunk.hasOrigin = true;
+    return true;
+}
+
+void WorldStreamer::ChooseLoaded(const ViewRect& view) {
+    // Chunks near the view, kept until they are further than unloadMargin
+    struct Candidate { float distance; int index; };
+    std::vector<Candidate> candidates;
+    for (auto& [index, chunk] : chunks_) {
+        bool loadable = chunk.state == ChunkState::Placed && (chunk.level || !chunk.data.is_null());
+        if (loadable) {
+            float distance = DistanceToView(chunk, view);
+            if (distance <= config_.loadMargin || (chunk.wanted && distance <= config_.unloadMargin))
+                candidates.push_back({ distance, index });
+        }
+        chunk.wanted = false;
+    }
+
+    // Nearest first until the budget is used up
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+    });
+    residentBytes_ = 0;
+    for (const Candidate& c : candidates) {
+        Chunk& chunk = chunks_.at(c.index);
+        if (residentBytes_ + chunk.estimate > config_.memoryBudget) continue;
+        chunk.wanted = true;
+        residentBytes_ += chunk.estimate;
+    }
+
+    // The GL side frees what was dropped; until then it stays alive for
+    // snapshots still pointing at it
+    for (auto& [index, chunk] : chunks_)
+        if (!chunk.wanted && chunk.level)
+            retired_.push_back(std::move(chunk.level));
+}
+
+bool WorldStreamer::Build(int index, Chunk& chunk, std::uint64_t gameSeed, unsigned int width, unsigned int height) {
+    auto start = std::chrono::steady_clock::now();
+
+    chunk.level = std::make_unique<Level>();
+    if (!chunk.level->Load(chunk.data, index, width, height, Random::Combine(gameSeed, static_cast<std::uint64_t>(index)))) {
+        chunk.level.reset();
+        chunk.buildFailed = true;
+        LOG_WARN("🌍 Level %d could not be streamed in; it keeps a loading transition", index);
+        return false;
+    }
+    ++revision_;
+
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    Stats::RecordLevelLoad(index, elapsed.count());
+    LOG_DEBUG("🌍 Streamed in level %d (%.2f ms, %zu KB)", index, elapsed.count(),
+              chunk.level->EstimateMemoryUsage() / 1024);
+    return true;
+}
+
+void WorldStreamer::Free(std::unique_ptr<Level> level, const Level& active) {
+    // Shaders are shared by name; only free what no other live level still
+    // uses (atlas textures are reference counted by the resource manager)
+    std::unordered_set<std::string> shaders(active.loadedShaderNames.begin(), active.loadedShaderNames.end());
+    for (const auto& [index, chunk] : chunks_)
+        if (chunk.level)
+            shaders.insert(chunk.level->loadedShaderNames.begin(), chunk.level->loadedShaderNames.end());
+    for (const auto& other : retired_)
+        shaders.insert(other->loadedShaderNames.begin(), other->loadedShaderNames.end());
+    std::erase_if(level->loadedShaderNames, [&](const std::string& n) { return shaders.count(n) > 0; });
+
+    level.reset();
+    ++revision_;
+}
+
+bool WorldStreamer::HandOver(std::unique_ptr<Level>& active, int index, std::uint64_t gameSeed,
+                             unsigned int width, unsigned int height) {
+    if (!config_.enabled || !active) return false;
+    auto it = chunks_.find(index);
+    if (it == chunks_.end()) return false;
+    Chunk& chunk = it->second;
+
+    // Only what Tick has already picked up counts; a read still in flight
+    // keeps the loading transition. Waiting for it (or not) by thread timing
+    // would let a replay take the other branch.
+    if (chunk.state != ChunkState::Placed) return false;
+
+    // Only a level sharing an edge with this one continues the world
+    glm::vec2 offset = ToActive(chunk);
+    bool touchesX = std::abs(offset.x - activeSize_.x) < 0.5f || std::abs(offset.x + chunk.size.x) < 0.5f;
+    bool touchesY = std::abs(offset.y - activeSize_.y) < 0.5f || std::abs(offset.y + chunk.size.y) < 0.5f;
+    if (!touchesX && !touchesY) return false;
+
+    // Not built by the GL side yet: the data is in memory, so build it now.
+    // A chunk waits frozen, so the result is the same as an earlier build.
+    if (!chunk.level) {
+        if (chunk.data.is_null() || chunk.buildFailed || !Build(index, chunk, gameSeed, width, height))
+            return false;
+    }
+
+    // Carry the dog across, just inside the new level's edge. This keeps
+    // walking seamless, so a transition's spawn point (meant for loads) is
+    // not used.
+    std::unique_ptr<Dog> dog = active->ReleaseDog();
+    glm::vec2 center = dog->GetBoundingCircle().center - offset;
+    float r = dog->GetBoundingCircle().radius;
+    center = glm::clamp(center, glm::vec2(r), glm::max(chunk.size - r, glm::vec2(r)));
+    dog->SetPosition(center - dog->GetSize() * 0.5f);
+
+    std::unique_ptr<Level> next = std::move(chunk.level);
+    next->AdoptDog(std::move(dog));
+    // The dog may land on the new level's own transition tiles (often the
+    // one back); they wait until it has stepped off
+    next->HoldTransitionsUntilClear();
+
+    // The camera carries on from where it was, in the new level's space
+    Camera camera = active->GetCamera();
+    glm::vec2 cameraCenter = camera.GetCenter() - offset;
+
+    // The old level stays loaded as a neighbour. Its data is read again in
+    // the background in case it is dropped and rebuilt later.
+    int previousIndex = activeIndex_;
+    Chunk previous;
+    previous.state = ChunkState::Placed;
+    previous.origin = activeOrigin_;
+    previous.size = activeSize_;
+    previous.hasOrigin = true;
+    previous.wanted = true;
+    previous.level = std::move(active);
+    previous.estimate = previous.level->EstimateMemoryUsage();
+    previous.pending = ReadAsync(previousIndex);
+    previous.dueTick = tick_ + ReadDueTicks;
+
+    activeOrigin_ = chunk.origin;
+    activeSize_ = chunk.size;
+    activeIndex_ = index;
+    chunks_.erase(it);
+    chunks_[previousIndex] = std::move(previous);
+
+    active = std::move(next);
+    active->GetCamera() = camera;
+    UpdateCameraBounds(*active);
+    active->GetCamera().SnapTo(cameraCenter);
+    ++revision_;
+
+    LOG_INFO("🌍 Walked from level %d into level %d", previousIndex, index);
+    return true;
+}
+
+void WorldStreamer::UpdateCameraBounds(Level& active) const {
+    // The levels chosen to be loaded, built yet or not: the GL side's timing
+    // must not reach the camera, which enemies see through
+    glm::vec2 min(0.0f), max = activeSize_;
+    for (const auto& [index, chunk] : chunks_) {
+        if (!chunk.wanted) continue;
+        min = glm::min(min, ToActive(chunk));
+        max = glm::max(max, ToActive(chunk) + chunk.size);
+    }
+    active.GetCamera().SetBounds(min, max);
+}
+
+void WorldStreamer::Render(const glm::mat4& proj, const ViewRect& visible) {
+    if (!config_.enabled) return;
+    for (auto& [index, chunk] : chunks_) {
+        if (!chunk.level) continue;
+        glm::vec2 offset = ToActive(chunk);
+        if (!visible.Overlaps(offset, offset + chunk.size)) continue;
+
+        ViewRect local{ visible.min - offset, visible.max - offset };
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f));
+        chunk.level->RenderView(proj * model, local, false);
+    }
+}
+
+void WorldStreamer::Snapshot(RenderSnapshot& out, const glm::mat4& proj, const ViewRect& visible) {
+    if (!config_.enabled) return;
+    for (auto& [index, chunk] : chunks_) {
+        if (!chunk.level) continue;
+        glm::vec2 offset = ToActive(chunk);
+        if (!visible.Overlaps(offset, offset + chunk.size)) continue;
+
+        ViewRect local{ visible.min - offset, visible.max - offset };
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f));
+        chunk.level->Snapshot(out, proj * model, local, false);
+    }
+}
+
+float WorldStreamer::DistanceToView(const Chunk& chunk, const ViewRect& view) const {
+    glm::vec2 min = ToActive(chunk);
+    glm::vec2 max = min + chunk.size;
+    glm::vec2 gap = glm::max(glm::max(min - view.max, view.min - max), glm::vec2(0.0f));
+    return std::max(gap.x, gap.y);
+}
@@ -0,0 +1,140 @@
+// WorldStreamer.h
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+
+#include "Camera.h"
+#include "Level.h"
+
+struct WorldStreamConfig {
+	bool enabled = false;
+	// Chunks within this many pixels of the view are loaded; they unload
+	// again once further than unloadMargin (hysteresis against thrashing)
+	float loadMargin = 128.0f;
+	float unloadMargin = 384.0f;
+	// Loaded neighbour chunks may hold at most this much (Level::EstimateMemoryUsage)
+	std::size_t memoryBudget = 64u << 20;
+};
+
+// Seamless world from the separate level files. Levels linked by a
+// transition on a map edge are laid out side by side in one world space,
+// rooted at the first level loaded. Neighbours of the active level are
+// read and parsed on a worker thread, loaded as the camera approaches,
+// drawn next to the active level, and unloaded again as the camera leaves
+// or the memory budget runs out. Walking through an edge transition into
+// a loaded neighbour then hands the dog over instead of reloading.
+//
+// Everything the simulation can see is decided in Tick, on tick counts
+// alone: reads are picked up a fixed number of ticks after they start, and
+// the camera is clamped to the levels chosen to be loaded, not to the ones
+// already built. Replays therefore stream exactly like the recording. The
+// GL side (Update, once per frame) only catches up: it builds at most one
+// chosen level and frees the dropped ones.
+//
+// Neighbours are frozen while the dog is elsewhere, like sleeping enemies.
+// A neighbour that would overlap an already placed level, or that alone
+// needs more than the memory budget, keeps the old loading transition.
+class WorldStreamer {
+public:
+	// Reads the optional "streaming" block of a world file
+	bool LoadConfig(const std::string& path);
+	const WorldStreamConfig& GetConfig() const { return config_; }
+	bool IsEnabled() const { return config_.enabled; }
+
+	// Drops every chunk and roots a new world at this level
+	void Reset(int activeIndex);
+
+	// Discovers chunks and picks which ones are loaded around the active
+	// level's camera. Once per simulation tick, after the active level's
+	// update; no GL work, so it may run off the GL thread.
+	void Tick(Level& active);
+	// Builds (at most one) and frees chunks as Tick chose. GL thread, once
+	// per frame.
+	void Update(Level& active, std::uint64_t gameSeed, unsigned int width, unsigned int height);
+
+	// Moves the dog from the active level into the neighbour index, if it is
+	// an adjacent chunk whose data is in. On success active holds the
+	// neighbour and the old level stays loaded as a chunk. Never waits for
+	// a read: a chunk still in flight keeps the loading transition. GL
+	// thread, at a tick boundary.
+	bool HandOver(std::unique_ptr<Level>& active, int index, std::uint64_t gameSeed,
+				  unsigned int width, unsigned int height);
+
+	// Draws the loaded neighbours around the active level
+	void Render(const glm::mat4& proj, const ViewRect& visible);
+	// Same, into a snapshot drawn later
+	void Snapshot(RenderSnapshot& out, const glm::mat4& proj, const ViewRect& visible);
+
+	// Bumped whenever a chunk is built, freed or handed over
+	std::uint64_t GetRevision() const { return revision_; }
+
+	// Estimated bytes of the chunks Tick chose to keep loaded
+	std::size_t GetResidentBytes() const { return residentBytes_; }
+	int GetActiveIndex() const { return activeIndex_; }
+
+private:
+	// A read started on tick t is picked up on tick t + ReadDueTicks
+	// (0.5 s at 120 Hz), waiting for it if the disk is slower still
+	static constexpr std::uint64_t ReadDueTicks = 60;
+
+	enum class ChunkState {
+		Reading,     // file read + parse running on a worker, position unknown
+		Placed,      // position known; data and level as below
+		Rejected,    // unreadable, overlaps another level, or over budget alone
+	};
+	struct Chunk {
+		ChunkState state = ChunkState::Reading;
+		glm::vec2 origin{ 0.0f };   // world position of the level's top-left
+		glm::vec2 size{ 0.0f };
+		bool hasOrigin = false;
+		// Edge placement next to the level that linked it, resolved once
+		// the size is known
+		glm::vec2 parentOrigin{ 0.0f }, parentSize{ 0.0f };
+		glm::ivec2 side{ 0 };
+		// Read in flight (also for a level left by the dog, to rebuild it later)
+		std::future<nlohmann::json> pending;
+		std::uint64_t dueTick = 0;
+		// Parsed level, kept so the chunk can be rebuilt without I/O
+		nlohmann::json data;
+		// Chosen by Tick to be loaded; the GL side builds it when it can
+		bool wanted = false;
+		std::unique_ptr<Level> level;
+		// GL side only: data that failed to load is not retried
+		bool buildFailed = false;
+		// Expected bytes once built, from the data (or the measured size of
+		// a level the dog left)
+		std::size_t estimate = 0;
+	};
+
+	void Discover(const Level& active);
+	void Resolve(int index, Chunk& chunk);
+	bool Place(int index, Chunk& chunk);
+	void ChooseLoaded(const ViewRect& view);
+	void UpdateCameraBounds(Level& active) const;
+	// False when the level data turns out malformed
+	bool Build(int index, Chunk& chunk, std::uint64_t gameSeed, unsigned int width, unsigned int height);
+	// Frees a level, keeping the shaders still used by another live one
+	void Free(std::unique_ptr<Level> level, const Level& active);
+	// Distance from a chunk to the view, in active-level coordinates
+	float DistanceToView(const Chunk& chunk, const ViewRect& view) const;
+	glm::vec2 ToActive(const Chunk& chunk) const { return chunk.origin - activeOrigin_; }
+
+	WorldStreamConfig config_;
+	int activeIndex_ = -1;
+	glm::vec2 activeOrigin_{ 0.0f };
+	glm::vec2 activeSize_{ 0.0f };
+	std::map<int, Chunk> chunks_;
+	// Levels Tick dropped; freed by the next Update on the GL thread
+	std::vector<std::unique_ptr<Level>> retired_;
+	std::uint64_t tick_ = 0;
+	std::size_t residentBytes_ = 0;
+	std::uint64_t revision_ = 0;
+};
@@ -0,0 +1,45 @@
+// BenchMain.cpp
+//
+// catchase_bench entry point. Unless --benchmark_out is given, results are
+// also written to catchase_bench.json so runs can be diffed across commits
+// (e.g. with Google Benchmark's tools/compare.py). Run from the build
+// directory so resources/ resolves.
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "Log.h"
+#include "RESOURCE_MANAGER.h"
+
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+
+    bool hasOut = false;
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0)
+            hasOut = true;
+
+    std::string outArg = "--benchmark_out=catchase_bench.json";
+    std::string formatArg = "--benchmark_out_format=json";
+    if (!hasOut) {
+        args.push_back(outArg.data());
+        args.push_back(formatArg.data());
+    }
+    int count = static_cast<int>(args.size());
+
+    // Keep level-load chatter out of the results table
+    Log::Init("catchase_bench.log");
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    ResourceManager::Clear();
+    glfwTerminate();
+    Log::Shutdown();
+    return 0;
+}
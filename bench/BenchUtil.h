@@ -0,0 +1,51 @@
+// BenchUtil.h
+#pragma once
+
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Several of the benchmarked classes create GL objects in their
+// constructors, so the benchmarks run with a hidden window current.
+inline bool EnsureBenchContext() {
+	static GLFWwindow* window = nullptr;
+	if (window) return true;
+
+	if (!glfwInit()) return false;
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	window = glfwCreateWindow(64, 64, "catchase_bench", nullptr, nullptr);
+	if (!window) return false;
+	glfwMakeContextCurrent(window);
+	return gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) != 0;
+}
+
+// Tile ID used for solid cells in synthetic maps
+constexpr int BenchSolidTile = 1;
+
+// A cols x rows map with roughly solidRatio of its cells solid. Seeded so
+// every run (and every commit) benchmarks the same layout.
+inline std::vector<std::vector<int>> MakeSyntheticMap(int cols, int rows, float solidRatio, unsigned seed = 1234) {
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+	std::vector<std::vector<int>> map(rows, std::vector<int>(cols, 0));
+	for (auto& row : map)
+		for (int& tile : row)
+			tile = dist(rng) < solidRatio ? BenchSolidTile : 0;
+	return map;
+}
+
+inline const std::unordered_set<int>& BenchSolidTiles() {
+	static const std::unordered_set<int> solid = { BenchSolidTile };
+	return solid;
+}
@@ -0,0 +1,91 @@
+// CollisionBench.cpp
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "BenchUtil.h"
+#include "Collision.h"
+
+namespace {
+    constexpr int TileSize = 16;
+    constexpr int QueryCount = 1024;
+
+    // Circles scattered over the whole map, sized like the dog / enemies
+    std::vector<Circle> MakeQueries(int cols, int rows) {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> x(0.0f, static_cast<float>(cols * TileSize));
+        std::uniform_real_distribution<float> y(0.0f, static_cast<float>(rows * TileSize));
+        std::uniform_real_distribution<float> r(4.0f, 12.0f);
+
+        std::vector<Circle> queries(QueryCount);
+        for (auto& c : queries)
+            c = { glm::vec2(x(rng), y(rng)), r(rng) };
+        return queries;
+    }
+}
+
+static void BM_IsCircleBlocked(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.25f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    auto queries = MakeQueries(size, size);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool blocked = IsCircleBlocked(queries[i++ % QueryCount], layers, TileSize, TileSize, BenchSolidTiles());
+        benchmark::DoNotOptimize(blocked);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsCircleBlocked)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_TryMoveCircle(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.25f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    auto queries = MakeQueries(size, size);
+    glm::vec2 bounds(static_cast<float>(size * TileSize));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Circle c = queries[i++ % QueryCount];
+        bool moved = TryMoveCircle(c, glm::vec2(100.0f, 40.0f), 1.0f / 60.0f, bounds,
+                                   layers, BenchSolidTiles(), TileSize, TileSize);
+        benchmark::DoNotOptimize(moved);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TryMoveCircle)->RangeMultiplier(4)->Range(16, 1024);
+
+// Several collidable layers, as levels stack them
+static void BM_IsCircleBlockedLayers(benchmark::State& state) {
+    int layerCount = static_cast<int>(state.range(0));
+    std::vector<std::vector<std::vector<int>>> maps;
+    for (int l = 0; l < layerCount; ++l)
+        maps.push_back(MakeSyntheticMap(64, 64, 0.1f, 1234 + l));
+    std::vector<const std::vector<std::vector<int>>*> layers;
+    for (const auto& m : maps) layers.push_back(&m);
+    auto queries = MakeQueries(64, 64);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool blocked = IsCircleBlocked(queries[i++ % QueryCount], layers, TileSize, TileSize, BenchSolidTiles());
+        benchmark::DoNotOptimize(blocked);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsCircleBlockedLayers)->DenseRange(1, 4);
+
+static void BM_CircleIntersect(benchmark::State& state) {
+    auto queries = MakeQueries(64, 64);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        bool hit = CircleIntersect(queries[i % QueryCount], queries[(i + 1) % QueryCount]);
+        ++i;
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CircleIntersect);
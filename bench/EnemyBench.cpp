@@ -0,0 +1,76 @@
+// EnemyBench.cpp
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "AnimationClip.h"
+#include "BenchUtil.h"
+#include "EnemyRegistry.h"
+#include "EnemyStore.h"
+#include "JobSystem.h"
+
+namespace {
+    constexpr int TileSize = 16;
+    constexpr int MapSize = 256;
+
+    // count patrolling enemies scattered over a MapSize x MapSize map
+    void FillStore(EnemyStore& store, int count) {
+        SpriteSheet anim(192.0f, 96.0f, 6, 3);
+        auto clip = anim.AddClip("idle", 2, 0, 4, 0.3f);
+        int animation = AnimationLibrary::Register("bench_slime", std::move(anim));
+        int typeId = EnemyRegistry::Register("bench_patrol", EnemyTypeParams{}, EnemyArchetype{});
+
+        std::uint16_t sheet = store.AddSheet(nullptr, nullptr, animation);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> pos(0.0f, static_cast<float>(MapSize * TileSize));
+        for (int i = 0; i < count; ++i)
+            store.Spawn(typeId, sheet, glm::vec2(pos(rng), pos(rng)), clip, 0.75f, 0.4f, Rng(1, i));
+    }
+}
+
+// args: enemy count, worker threads (0 = update on the calling thread only)
+static void BM_EnemyUpdate(benchmark::State& state) {
+    if (!EnsureBenchContext()) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+    int count = static_cast<int>(state.range(0));
+    auto workers = static_cast<unsigned int>(state.range(1));
+
+    auto map = MakeSyntheticMap(MapSize, MapSize, 0.1f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    EnemyStore store;
+    store.SetActivityConfig({ 0.0f });   // everyone runs the full update
+    FillStore(store, count);
+    Circle player = { glm::vec2(MapSize * TileSize * 0.5f), 8.0f };
+
+    if (workers > 0) JobSystem::Init(workers);
+    for (auto _ : state)
+        store.Update(1.0f / 120.0f, layers, BenchSolidTiles(), TileSize, TileSize, player);
+    JobSystem::Shutdown();
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_EnemyUpdate)->ArgsProduct({ { 64, 1024, 16384 }, { 0, 2, 4, 8 } });
+
+// Same, with the default activity radii: most of the map is reduced or asleep
+static void BM_EnemyUpdateLod(benchmark::State& state) {
+    if (!EnsureBenchContext()) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+    int count = static_cast<int>(state.range(0));
+
+    auto map = MakeSyntheticMap(MapSize, MapSize, 0.1f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    EnemyStore store;
+    FillStore(store, count);
+    Circle player = { glm::vec2(MapSize * TileSize * 0.5f), 8.0f };
+
+    for (auto _ : state)
+        store.Update(1.0f / 120.0f, layers, BenchSolidTiles(), TileSize, TileSize, player);
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["awake"] = static_cast<double>(store.GetAwakeCount());
+}
+BENCHMARK(BM_EnemyUpdateLod)->Arg(1024)->Arg(16384);
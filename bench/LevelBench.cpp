@@ -0,0 +1,59 @@
+// LevelBench.cpp
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+#include "BenchUtil.h"
+#include "AnimationClip.h"
+#include "EnemyRegistry.h"
+#include "Level.h"
+#include "RESOURCE_MANAGER.h"
+
+namespace {
+    std::string ReadLevelFile(int index) {
+        std::ifstream file("resources/levels/level" + std::to_string(index) + ".json");
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+}
+
+// JSON parsing alone, from memory
+static void BM_LevelParseJson(benchmark::State& state) {
+    std::string text = ReadLevelFile(static_cast<int>(state.range(0)));
+    if (text.empty()) {
+        state.SkipWithError("level file not found (run from the build directory)");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto data = nlohmann::json::parse(text);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_LevelParseJson)->DenseRange(0, 2);
+
+// Full Level::Load: file read, parse, shader/texture loads, entity setup
+static void BM_LevelLoad(benchmark::State& state) {
+    if (!EnsureBenchContext()) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+    // Level::Load hands the "default" text renderer to its tile layers
+    if (!ResourceManager::TextRenderers.count("default"))
+        ResourceManager::LoadTextRenderer("default", 1920, 1080)->Load("resources/fonts/OCRAEXT.TTF", 20);
+
+    AnimationLibrary::LoadFromFile("resources/animations.json");
+    EnemyRegistry::LoadFromFile("resources/enemies.json");
+
+    int index = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Level level;
+        level.Load(index, 1920, 1080);
+        benchmark::DoNotOptimize(level.tileLayers.data());
+    }
+}
+BENCHMARK(BM_LevelLoad)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
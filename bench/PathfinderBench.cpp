@@ -0,0 +1,157 @@
+// PathfinderBench.cpp
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "BenchUtil.h"
+#include "FlowField.h"
+#include "HierarchicalPathfinder.h"
+#include "Pathfinder.h"
+
+namespace {
+    constexpr int TileSize = 16;
+    constexpr int QueryCount = 256;
+
+    struct PathQuery {
+        glm::ivec2 start, goal;
+    };
+
+    // Random open start/goal pairs, seeded so every run asks the same questions
+    std::vector<PathQuery> MakeQueries(const NavGrid& grid) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> x(0, grid.GetWidth() - 1);
+        std::uniform_int_distribution<int> y(0, grid.GetHeight() - 1);
+        auto openCell = [&] {
+            glm::ivec2 c;
+            do { c = { x(rng), y(rng) }; } while (grid.IsBlocked(c.x, c.y));
+            return c;
+        };
+
+        std::vector<PathQuery> queries(QueryCount);
+        for (auto& q : queries)
+            q = { openCell(), openCell() };
+        return queries;
+    }
+}
+
+// Every query is a full A* search
+static void BM_AStarSearch(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.2f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    NavGrid grid;
+    grid.Build(layers, BenchSolidTiles(), TileSize, TileSize);
+    Pathfinder pathfinder;
+    pathfinder.SetGrid(&grid);
+    auto queries = MakeQueries(grid);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const PathQuery& q = queries[i++ % QueryCount];
+        pathfinder.ClearCache();
+        benchmark::DoNotOptimize(pathfinder.FindPath(q.start, q.goal).found);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AStarSearch)->RangeMultiplier(4)->Range(16, 256);
+
+// Repeated queries, as when enemies hold still relative to the dog
+static void BM_AStarCached(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.2f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    NavGrid grid;
+    grid.Build(layers, BenchSolidTiles(), TileSize, TileSize);
+    Pathfinder pathfinder;
+    pathfinder.SetGrid(&grid);
+    auto queries = MakeQueries(grid);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const PathQuery& q = queries[i++ % QueryCount];
+        benchmark::DoNotOptimize(pathfinder.FindPath(q.start, q.goal).found);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AStarCached)->RangeMultiplier(4)->Range(16, 256);
+
+// One flow-field rebuild, i.e. the cost each time the dog changes tile
+static void BM_FlowFieldBuild(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.2f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    NavGrid grid;
+    grid.Build(layers, BenchSolidTiles(), TileSize, TileSize);
+    FlowField field;
+    field.SetGrid(&grid);
+    auto queries = MakeQueries(grid);
+
+    std::size_t i = 0;
+    for (auto _ : state)
+        field.Update(queries[i++ % QueryCount].goal, true);
+    state.SetItemsProcessed(state.iterations() * grid.GetCellCount());
+}
+BENCHMARK(BM_FlowFieldBuild)->RangeMultiplier(4)->Range(16, 256);
+
+// HPA* coarse route (no cache), against BM_AStarSearch on the same maps
+static void BM_HierarchicalRoute(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.2f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    NavGrid grid;
+    grid.Build(layers, BenchSolidTiles(), TileSize, TileSize);
+    HierarchicalPathfinder hierarchical;
+    hierarchical.Build(&grid);
+    auto queries = MakeQueries(grid);
+
+    std::vector<glm::ivec2> route;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const PathQuery& q = queries[i++ % QueryCount];
+        benchmark::DoNotOptimize(hierarchical.FindRoute(q.start, q.goal, route));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HierarchicalRoute)->RangeMultiplier(4)->Range(16, 1024);
+
+// One runtime tile edit (Level::SetTileBlocked): toggle a cell, patch HPA*
+// incrementally, then route. Every route is checked against flat A* on the
+// edited grid, so a stale cluster after OnTileChanged fails the benchmark.
+static void BM_HierarchicalTileEdit(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto map = MakeSyntheticMap(size, size, 0.2f);
+    std::vector<const std::vector<std::vector<int>>*> layers = { &map };
+    NavGrid grid;
+    grid.Build(layers, BenchSolidTiles(), TileSize, TileSize);
+    HierarchicalPathfinder hierarchical;
+    hierarchical.Build(&grid);
+    Pathfinder pathfinder;
+    pathfinder.SetGrid(&grid);
+    auto queries = MakeQueries(grid);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell(0, size - 1);
+    std::vector<glm::ivec2> route;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        glm::ivec2 edit(cell(rng), cell(rng));
+        const PathQuery& q = queries[i++ % QueryCount];
+        grid.SetBlocked(edit.x, edit.y, !grid.IsBlocked(edit.x, edit.y));
+        hierarchical.OnTileChanged(edit.x, edit.y);
+        bool found = hierarchical.FindRoute(q.start, q.goal, route);
+
+        // Earlier edits may have walled in the query's own cells; only open
+        // endpoints make a question both searches answer the same way
+        if (grid.IsBlocked(q.start.x, q.start.y) || grid.IsBlocked(q.goal.x, q.goal.y)) continue;
+        state.PauseTiming();
+        pathfinder.ClearCache();
+        bool expected = pathfinder.FindPath(q.start, q.goal).found;
+        state.ResumeTiming();
+        if (found != expected) {
+            state.SkipWithError("HPA* disagrees with A* after a tile edit");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HierarchicalTileEdit)->RangeMultiplier(4)->Range(16, 256);
@@ -0,0 +1,59 @@
+// TextBench.cpp
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "BenchUtil.h"
+#include "RESOURCE_MANAGER.h"
+
+namespace {
+    TextRenderer* BenchFont() {
+        static std::shared_ptr<TextRenderer> text;
+        if (!text && EnsureBenchContext()) {
+            text = ResourceManager::LoadTextRenderer("bench", 1920, 1080);
+            text->Load("resources/fonts/OCRAEXT.TTF", 20);
+        }
+        return text.get();
+    }
+
+    std::string MakeText(int length) {
+        static const std::string sample = "The quick brown fox jumps over the lazy dog. 0123456789 ";
+        std::string s;
+        while (static_cast<int>(s.size()) < length)
+            s += sample;
+        s.resize(length);
+        return s;
+    }
+}
+
+static void BM_MeasureTextWidth(benchmark::State& state) {
+    TextRenderer* text = BenchFont();
+    if (!text) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+    std::string s = MakeText(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        float w = text->MeasureTextWidth(s, 1.5f);
+        benchmark::DoNotOptimize(w);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeasureTextWidth)->RangeMultiplier(4)->Range(8, 512);
+
+static void BM_MeasureRenderedTextBounds(benchmark::State& state) {
+    TextRenderer* text = BenchFont();
+    if (!text) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+    std::string s = MakeText(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        glm::vec4 bounds = text->MeasureRenderedTextBounds(s, 100.0f, 100.0f, 1.5f);
+        benchmark::DoNotOptimize(bounds);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MeasureRenderedTextBounds)->RangeMultiplier(4)->Range(8, 512);
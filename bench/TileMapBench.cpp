@@ -0,0 +1,90 @@
+// TileMapBench.cpp
+#include <benchmark/benchmark.h>
+
+#include "BenchUtil.h"
+#include "JobSystem.h"
+#include "RenderQueue.h"
+#include "TileMap.h"
+
+// Per-tile position + UV math that TileMap::Submit does for every cell,
+// without queueing.
+static void BM_TileQuadPrep(benchmark::State& state) {
+    if (!EnsureBenchContext()) {
+        state.SkipWithError("no GL context");
+        return;
+    }
+
+    int size = static_cast<int>(state.range(0));
+    TileMap map(nullptr, nullptr, 224, 240, 16, 16);
+    auto data = MakeSyntheticMap(size, size, 0.0f);
+    // Spread IDs over the whole tileset, with some empty cells
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            data[y][x] = ((x * 7 + y * 13) % 211) - 1;
+    map.Load(data);
+
+    glm::vec2 position;
+    glm::vec4 uvRect;
+    for (auto _ : state) {
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                if (map.ComputeTileQuad(x, y, position, uvRect)) {
+                    benchmark::DoNotOptimize(position);
+                    benchmark::DoNotOptimize(uvRect);
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_TileQuadPrep)->RangeMultiplier(2)->Range(16, 256);
+
+// Queueing and radix-sorting a full screen of tiles plus enemies, the CPU
+// side of a frame's sprite submission
+static void BM_RenderQueueSort(benchmark::State& state) {
+    auto count = static_cast<std::size_t>(state.range(0));
+    RenderQueue queue;
+    queue.Reserve(count);
+
+    SpriteCommand cmd;
+    cmd.size = glm::vec2(16.0f);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; ++i) {
+            // A few layers and textures, depth scattered within them
+            auto layer = static_cast<std::uint8_t>(i % 3);
+            auto texture = static_cast<unsigned int>(1 + (i * 7) % 5);
+            auto depth = static_cast<std::uint32_t>((i * 2654435761u) & 0xFFFF);
+            queue.Submit(RenderQueue::MakeKey(layer, 1, texture, depth), cmd);
+        }
+        queue.Sort();
+        benchmark::DoNotOptimize(queue.GetOrder().data());
+        queue.Clear();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_RenderQueueSort)->RangeMultiplier(4)->Range(256, 65536);
+
+// Building a layer's tile commands, args: map size, worker threads
+// (0 = on the calling thread only)
+static void BM_TileMapSubmit(benchmark::State& state) {
+    int size = static_cast<int>(state.range(0));
+    auto workers = static_cast<unsigned int>(state.range(1));
+
+    TileMap map(nullptr, nullptr, 224, 240, 16, 16);
+    auto data = MakeSyntheticMap(size, size, 0.0f);
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            data[y][x] = ((x * 7 + y * 13) % 211) - 1;
+    map.Load(data);
+
+    RenderQueue queue;
+    if (workers > 0) JobSystem::Init(workers);
+    for (auto _ : state) {
+        map.Submit(queue, 0);
+        benchmark::DoNotOptimize(queue.Size());
+        queue.Clear();
+    }
+    JobSystem::Shutdown();
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_TileMapSubmit)->ArgsProduct({ { 64, 256 }, { 0, 4 } });
@@ -1,12 +1,10 @@
 #include "game.h"
 
 #include <unordered_set>
-#include <cstdlib> // for rand()
-#include <ctime>   // for seeding rand (e.g., in main())
 
 #include "Dog.h"
-#include "Enemies.h"
-#include "Enemy.h"
+#include "AnimationClip.h"
+#include "EnemyRegistry.h"
 #include "RESOURCE_MANAGER.h"
 #include "TileMap.h"
 #include "Collision.h"
@@ -22,7 +20,7 @@ bool isPaused = false;
 
 
 Game::Game(unsigned int width, unsigned int height)
-    : State(GAME_ACTIVE), Keys(), Width(width), Height(height)
+    : State(GAME_ACTIVE), Width(width), Height(height)
 {
 }
 
@@ -33,9 +31,13 @@ Game::~Game()
     ResourceManager::Clear(); // unloads ALL shaders/textures
 }
 
-void Game::Init() {
+void Game::Init(unsigned int seed) {
 
-    srand(static_cast<unsigned>(time(nullptr)));
+    // Seeded by main so replays can reproduce enemy patrols
+    levelManager_.SetSeed(seed);
+    levelManager_.LoadWorldConfig("resources/world.json");
+    AnimationLibrary::LoadFromFile("resources/animations.json");
+    EnemyRegistry::LoadFromFile("resources/enemies.json");
     ResourceManager::LoadShader("resources/shaders/pause.vert", "resources/shaders/pause.frag", nullptr, "pause");
     ResourceManager::LoadShader("resources/shaders/box.vert", "resources/shaders/box.frag", nullptr, "box");
 
@@ -57,35 +59,85 @@ void Game::Update(float dt)
 {	 if (!isPaused) levelManager_.Update(dt);
 }
 
-void Game::ProcessInput(GLFWwindow* window, float dt)
+void Game::OnKey(int key, int action, double time)
 {
-    static bool pausePressed = false;
+    if (action == GLFW_REPEAT) return;
+    bool pressed = action == GLFW_PRESS;
 
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !pausePressed) {
+    // F3 toggles the perf overlay, also while paused
+    if (pressed && key == GLFW_KEY_F3)
+        perfOverlay_.Toggle();
+
+    // During playback the replay owns the simulation's input
+    if (ReplayMode) return;
+
+    if (pressed && key == GLFW_KEY_ESCAPE) {
         isPaused = !isPaused;
         pauseMenu.SetActive(isPaused);
-        pausePressed = true;
-    }
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_RELEASE) {
-        pausePressed = false;
     }
+    Input.OnKey(key, pressed, time);
+}
 
+void Game::ProcessInput(float dt)
+{
     if (isPaused) {
         return;
     }
 
-    levelManager_.ProcessInput(dt, Keys);
+    levelManager_.ProcessInput(dt, Input.GetActions());
 }
 
 void Game::Render()
 {
 
 
-	const glm::mat4& projection = levelManager_.GetCurrentLevel()->GetProjection();
+	const glm::mat4& projection = levelManager_.GetCurrentLevel()->GetViewProjection();
 	levelManager_.Render(projection);
 
 }
 
+void Game::SetPipelined(bool pipelined)
+{
+	levelManager_.SetDeferGLWork(pipelined);
+}
+
+bool Game::HasPendingGLWork() const
+{
+	return levelManager_.HasPendingGLWork();
+}
+
+void Game::RunGLWork()
+{
+	levelManager_.RunGLWork();
+}
+
+void Game::BuildSnapshot(RenderSnapshot& out)
+{
+	levelManager_.Snapshot(out);
+}
+
+std::uint64_t Game::GetRenderRevision() const
+{
+	return levelManager_.GetRevision();
+}
+
+glm::vec2 Game::GetInternalResolution() const
+{
+	const Level* level = levelManager_.GetCurrentLevel();
+	return level ? glm::vec2(level->GetInternalWidth(), level->GetInternalHeight()) : glm::vec2(496.0f, 272.0f);
+}
+
+void Game::LoadLevel(int index)
+{
+	if (Recorder) Recorder->RecordLevelLoad(index);
+	levelManager_.LoadLevel(index, Width, Height);
+}
+
+bool Game::IsPaused() const
+{
+	return isPaused;
+}
+
 void Game::SetSize(unsigned int width, unsigned int height)
 {
 	this->Width = width;
@@ -111,11 +163,14 @@ void Game::RenderUI() {
 	if (!GUI) return;
 
 	struct nk_context* ctx = GUI->GetContext();
-	if (!pauseMenu.IsActive()) return;
 
 	// Get current window size (so Nuklear scales correctly)
 	glfwGetFramebufferSize(glfwGetCurrentContext(), (int*)&Width, (int*)&Height);
 
+	perfOverlay_.Render(ctx, static_cast<float>(Width), static_cast<float>(Height));
+
+	if (!pauseMenu.IsActive()) return;
+
 	// Dynamic size: 30% width, 40% height
 	float menuWidth = Width * 0.3f;
 	float menuHeight = Height * 0.4f;
@@ -181,7 +236,7 @@ nk_style backup = ctx->style;
 			for (int i = 0; i < numLevels; ++i) {
 				if (nk_combo_item_label(ctx, levels[i], NK_TEXT_LEFT)) {
 					selectedLevel = i;
-					levelManager_.LoadLevel(i, Width, Height);
+					LoadLevel(i);
 					isPaused = false;
 					pauseMenu.SetActive(false);
 				}
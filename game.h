@@ -13,10 +13,12 @@
 #include <GLFW/glfw3.h>
 
 #include "Dog.h"
-#include "Enemy.h"
 #include "TileMap.h"
 #include "LevelManager.h"
 #include "PauseMenu.h"
+#include "PerfOverlay.h"
+#include "Input.h"
+#include "Replay.h"
 
 #include "NuklearRenderer.h" // Forward-declared or included
 #include <nuklear.h>
@@ -38,18 +40,40 @@ public:
 	Game(unsigned int width, unsigned int height);
 	~Game();
 
-	void Init();
-	void ProcessInput(GLFWwindow* window, float dt);
+	void Init(unsigned int seed);
+	// From the GLFW key callback: hotkeys act at once, everything else is
+	// queued on Input for the simulation
+	void OnKey(int key, int action, double time);
+	// Per tick, after Input.BeginTick
+	void ProcessInput(float dt);
 	void Update(float dt);
 	void Render();
+
+	// Pipelined frames (FramePipeline): Update may run on another thread and
+	// leaves level loads to RunGLWork on the GL thread. RunGLWork also builds
+	// streamed levels, so it runs once per frame in either mode.
+	void SetPipelined(bool pipelined);
+	bool HasPendingGLWork() const;
+	void RunGLWork();
+	void BuildSnapshot(RenderSnapshot& out);
+	std::uint64_t GetRenderRevision() const;
+	// The active level's internal resolution (the default with none loaded)
+	glm::vec2 GetInternalResolution() const;
 	void SetSize(unsigned int width, unsigned int height);
 
 	void HandlePauseMenuSelection(PauseMenu::Option opt, GLFWwindow *window);
 
+	// Loads a level from outside the simulation (menus); recorded for replays
+	void LoadLevel(int index);
+	bool IsPaused() const;
+
 
 	GameState State;
-	bool Keys[1024];
+	InputSystem Input;
 	unsigned int Width, Height;
+	// Replays drive Input themselves and must never pause
+	bool ReplayMode = false;
+	ReplayRecorder* Recorder = nullptr;
 
 	void RenderUI();  // new
 	void SetUIRenderer(NuklearRenderer* gui);
@@ -59,9 +83,8 @@ public:
 private:
 	TileMap* TileMap_;
 	Dog* dog_;
-	Enemy* slime1_;
-	Enemy* skeleton1_;
 	LevelManager levelManager_;
+	PerfOverlay perfOverlay_;
 };
 
 #endif
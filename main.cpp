@@ -4,8 +4,21 @@
 #include "game.h"
 #include "resource_manager.h"
 #include "NuklearRenderer.h"
+#include "JobSystem.h"
+#include "Log.h"
+#include "FramePacer.h"
+#include "FramePipeline.h"
+#include "FrameUniforms.h"
+#include "GLState.h"
+#include "RenderQueue.h"
+#include "Stats.h"
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -23,6 +36,55 @@ Game CatChase(SCREEN_WIDTH, SCREEN_HEIGHT);
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
+// Command line:
+//   --log <file>       write the log to a file instead of the console
+//   --record <file>    record input + RNG seed to a replay file
+//   --replay <file>    play a replay back instead of reading the keyboard
+//   --headless         with --replay: no window, simulate as fast as possible
+//   --pipeline         simulate the next frame while this one is drawn
+//   --max-latency <ms> with --pipeline: input-to-screen bound (0 = none)
+//   --vsync <mode>     on (default), off or adaptive
+//   --fps <n>          frame rate limit (0 = none)
+//   --jit              sample input just in time before present
+struct LaunchOptions {
+    const char* logPath = nullptr;
+    std::string recordPath;
+    std::string replayPath;
+    bool headless = false;
+    FramePipelineConfig pipeline;
+    FramePacingConfig pacing;
+};
+
+static VsyncMode ParseVsync(const std::string& mode) {
+    if (mode == "off") return VsyncMode::Off;
+    if (mode == "adaptive") return VsyncMode::Adaptive;
+    return VsyncMode::On;
+}
+
+static LaunchOptions ParseOptions(int argc, char* argv[]) {
+    LaunchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--log" && hasValue) options.logPath = argv[++i];
+        else if (arg == "--record" && hasValue) options.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) options.replayPath = argv[++i];
+        else if (arg == "--headless") options.headless = true;
+        else if (arg == "--pipeline") options.pipeline.enabled = true;
+        else if (arg == "--max-latency" && hasValue) options.pipeline.maxLatencyMs = std::stof(argv[++i]);
+        else if (arg == "--vsync" && hasValue) options.pacing.vsync = ParseVsync(argv[++i]);
+        else if (arg == "--fps" && hasValue) options.pacing.targetFps = std::stof(argv[++i]);
+        else if (arg == "--jit") options.pacing.justInTime = true;
+    }
+    return options;
+}
+
+static void ReportFrameTimes(const char* label, const FrameTimeSeries& series) {
+    FrameTimeSeries::Summary s = series.Summarize();
+    LOG_INFO("▶️ %s: %zu samples  avg %.3f ms  min %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f  stddev %.3f",
+             label, s.count, s.avgMs, s.minMs, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs, s.stdDevMs);
+}
+
 int main(int argc, char* argv[]) {
 #ifdef _WIN32
     char path[MAX_PATH];
@@ -32,6 +94,17 @@ int main(int argc, char* argv[]) {
     _chdir(exePath.c_str());
 #endif
 
+    LaunchOptions options = ParseOptions(argc, argv);
+    Log::Init(options.logPath);
+
+    ReplayPlayer player;
+    bool replaying = !options.replayPath.empty();
+    if (replaying && !player.Load(options.replayPath)) {
+        Log::Shutdown();
+        return -1;
+    }
+    bool headless = replaying && options.headless;
+
     // Initialize GLFW
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -41,74 +114,256 @@ int main(int argc, char* argv[]) {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
     glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+    // Headless playback still needs a context to load level textures
+    glfwWindowHint(GLFW_VISIBLE, headless ? GLFW_FALSE : GLFW_TRUE);
 
     GLFWwindow* window = glfwCreateWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "CatChase", nullptr, nullptr);
     if (!window) {
         std::cerr << "❌ Failed to create GLFW window" << std::endl;
         glfwTerminate();
+        Log::Shutdown();
         return -1;
     }
     glfwMakeContextCurrent(window);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "❌ Failed to initialize GLAD" << std::endl;
+        Log::Shutdown();
         return -1;
     }
 
+    JobSystem::Init();
+
     glfwSetKeyCallback(window, key_callback);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
     glViewport(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::SetBlend(true);
+    GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    FrameUniforms::Init();
 
     // Initialize Nuklear
     NuklearRenderer nuklearGui(window);
 
-    // Pass GUI to Game
+    // Initialize game. The seed drives enemy patrols, so replays reuse the recorded one.
+    unsigned int seed = replaying ? player.GetSeed() : static_cast<unsigned int>(time(nullptr));
+    CatChase.ReplayMode = replaying;
+    CatChase.Init(seed);
 
+    CatChase.SetUIRenderer(&nuklearGui);
 
-    // Initialize game
-    CatChase.Init();
+    // Fixed simulation step so a replay re-drives exactly the recorded ticks
+    const float simulationStep = replaying ? player.GetTickStep() : 1.0f / 120.0f;
+    constexpr int MaxTicksPerFrame = 8;
 
-    CatChase.SetUIRenderer(&nuklearGui);
+    ReplayRecorder recorder;
+    if (!options.recordPath.empty() && !replaying) {
+        recorder.Begin(options.recordPath, seed, simulationStep);
+        CatChase.Recorder = &recorder;
+    }
 
-    float deltaTime = 0.0f;
-    float lastFrame = 0.0f;
+    // Replays load levels in the middle of their ticks, so they always run
+    // the frame stages back to back
+    bool pipelined = options.pipeline.enabled && !replaying;
+    CatChase.SetPipelined(pipelined);
 
-    while (!glfwWindowShouldClose(window)) {
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+    // One simulation tick, applying the key events stamped up to tickEnd;
+    // false once a replay has run out of input
+    std::vector<InputEvent> replayEvents;
+    auto simulateTick = [&](double tickEnd) -> bool {
+        if (replaying) {
+            int levelLoad = -1;
+            if (!player.NextTick(replayEvents, levelLoad))
+                return false;
+            if (levelLoad >= 0)
+                CatChase.LoadLevel(levelLoad);
+            CatChase.Input.BeginTick(replayEvents);
+        } else {
+            CatChase.Input.BeginTick(tickEnd);
+        }
+        CatChase.ProcessInput(simulationStep);
+        if (recorder.IsRecording()) {
+            if (CatChase.IsPaused())
+                recorder.HoldEvents(CatChase.Input.GetTickEvents());
+            else
+                recorder.RecordTick(CatChase.Input.GetTickEvents());
+        }
+        CatChase.Update(simulationStep);
+        return true;
+    };
 
-        glfwPollEvents();
+    // The fixed-step ticks of one frame. They split the input time since
+    // the last frame evenly, so several events of one frame land in the
+    // ticks they happened in; the last tick takes everything up to
+    // inputTime. False once a replay is done.
+    float accumulator = 0.0f;
+    double lastInputTime = glfwGetTime();
+    auto simulateFrame = [&](double inputTime, float frameDt) -> bool {
+        accumulator += std::min(frameDt, 0.25f);
+        int ticks = std::min(static_cast<int>(accumulator / simulationStep), MaxTicksPerFrame);
+        double sliceStart = lastInputTime;
+        lastInputTime = inputTime;
+        for (int i = 0; i < ticks; ++i) {
+            // A level transition waiting for the GL thread ends the frame
+            // early; the rest of the time carries over
+            if (CatChase.HasPendingGLWork())
+                return true;
+            double tickEnd = i + 1 == ticks ? inputTime : sliceStart + (inputTime - sliceStart) * (i + 1) / ticks;
+            if (!simulateTick(tickEnd))
+                return false;
+            accumulator -= simulationStep;
+        }
+        // Too far behind: drop the backlog rather than spiral
+        if (ticks == MaxTicksPerFrame)
+            accumulator = 0.0f;
+        return true;
+    };
 
-        nuklearGui.BeginFrame();         // UI input
-        CatChase.ProcessInput(window, deltaTime);
-        CatChase.Update(deltaTime);
+    FramePipeline pipeline(options.pipeline);
+    if (pipelined) {
+        pipeline.Start([&](double inputTime, float frameDt) { simulateFrame(inputTime, frameDt); },
+                       [](RenderSnapshot& out) { CatChase.BuildSnapshot(out); });
+    }
+
+    FrameTimeSeries frameTimes;
+    if (replaying) frameTimes.Reserve(player.GetTickCount());
+
+    if (headless) {
+        // Simulate every recorded tick back to back and time each one
+        while (!player.IsFinished()) {
+            auto start = std::chrono::steady_clock::now();
+            if (!simulateTick(0.0)) break;
+            // No frames here: each tick stands in for one
+            CatChase.RunGLWork();
+            std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            frameTimes.Add(elapsed.count());
+        }
+        ReportFrameTimes("tick time (headless)", frameTimes);
+    } else {
+        FramePacer pacer(options.pacing);
+        pacer.Init(window);
+
+        float deltaTime = 0.0f;
+        float lastFrame = glfwGetTime();
+        bool replayDone = false;
+
+        while (!glfwWindowShouldClose(window) && !replayDone) {
+            Stats::BeginFrame();
+            {
+                // Just in time: hold the frame back so input is fresh at present
+                ScopedPhaseTimer timer(StatPhase::Pacing);
+                pacer.BeginFrame();
+            }
+
+            float currentFrame = glfwGetTime();
+            deltaTime = currentFrame - lastFrame;
+            lastFrame = currentFrame;
+
+            double inputTime;
+            {
+                ScopedPhaseTimer timer(StatPhase::Input);
+                glfwPollEvents();
+                // Every key event polled so far is simulated this frame
+                inputTime = glfwGetTime();
+
+                nuklearGui.BeginFrame();         // UI input
+            }
 
-        glClearColor(0.2f, 0.2f, 0.2f, 0.1f);
-        glClear(GL_COLOR_BUFFER_BIT);
+            if (pipelined) {
+                // The simulation stage is idle until Kick (and was while the
+                // hotkeys ran in polling): the UI and the GL work it asked
+                // for may touch the game now
+                {
+                    ScopedPhaseTimer timer(StatPhase::UI);
+                    CatChase.RenderUI();         // UI logic; drawn after the world
+                }
+                {
+                    ScopedPhaseTimer timer(StatPhase::Update);
+                    CatChase.RunGLWork();
+                    // Levels came or went since the snapshot: its textures may be gone
+                    if (pipeline.Front().GetRevision() != CatChase.GetRenderRevision())
+                        CatChase.BuildSnapshot(pipeline.Front());
+                    pipeline.Kick(inputTime, deltaTime, deltaTime * 1000.0f);
+                }
+                {
+                    ScopedPhaseTimer timer(StatPhase::Render, true);
+                    glClearColor(0.2f, 0.2f, 0.2f, 0.1f);
+                    glClear(GL_COLOR_BUFFER_BIT);
 
-        CatChase.Render();
-        CatChase.RenderUI();             // UI draw
-        nuklearGui.EndFrame();           // UI render
+                    FrameUniforms::BeginFrame(currentFrame, static_cast<float>(CatChase.Width), static_cast<float>(CatChase.Height),
+                                             CatChase.GetInternalResolution());
 
-        glfwSwapBuffers(window);
+                    pipeline.Front().Draw();
+                }
+                {
+                    ScopedPhaseTimer timer(StatPhase::UI, true);
+                    nuklearGui.EndFrame();
+                }
+
+                {
+                    ScopedPhaseTimer timer(StatPhase::Pacing);
+                    pacer.Present();
+                }
+                {
+                    // Whatever of the next frame's simulation the render didn't hide
+                    ScopedPhaseTimer timer(StatPhase::Update);
+                    pipeline.Wait();
+                }
+                Stats::EndFrame(deltaTime * 1000.0f);
+                continue;
+            }
+
+            {
+                ScopedPhaseTimer timer(StatPhase::Update);
+                if (!simulateFrame(inputTime, deltaTime))
+                    replayDone = true;
+                CatChase.RunGLWork();
+            }
+            {
+                ScopedPhaseTimer timer(StatPhase::Render, true);
+                glClearColor(0.2f, 0.2f, 0.2f, 0.1f);
+                glClear(GL_COLOR_BUFFER_BIT);
+
+                FrameUniforms::BeginFrame(currentFrame, static_cast<float>(CatChase.Width), static_cast<float>(CatChase.Height),
+                                             CatChase.GetInternalResolution());
+
+                CatChase.Render();
+            }
+            {
+                ScopedPhaseTimer timer(StatPhase::UI, true);
+                CatChase.RenderUI();             // UI draw
+                nuklearGui.EndFrame();           // UI render
+            }
+
+            {
+                ScopedPhaseTimer timer(StatPhase::Pacing);
+                pacer.Present();
+            }
+            Stats::EndFrame(deltaTime * 1000.0f);
+            if (replaying) frameTimes.Add(deltaTime * 1000.0f);
+        }
+
+        if (replaying)
+            ReportFrameTimes("frame time", frameTimes);
+        pacer.LogReport();
     }
 
+    pipeline.Stop();
+    CatChase.Recorder = nullptr;
+    recorder.End();
+
+    FrameUniforms::Shutdown();
+    RenderQueue::Shutdown();
     ResourceManager::Clear();
     glfwTerminate();
+    JobSystem::Shutdown();
+    Log::Shutdown();
     return 0;
 }
 
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (key >= 0 && key < 1024) {
-        if (action == GLFW_PRESS)
-            CatChase.Keys[key] = true;
-        else if (action == GLFW_RELEASE)
-            CatChase.Keys[key] = false;
-    }
+    // GLFW has no event timestamps; the time of the callback is the closest
+    CatChase.OnKey(key, action, glfwGetTime());
 }
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
@@ -1,10 +1,17 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 
-uniform mat4 projection;
+layout (std140) uniform Frame {
+    mat4 viewProjection;
+    mat4 screenProjection;
+    vec4 resolution;
+    vec4 internalResolution;
+    float time;
+};
+
 uniform mat4 model;
 
 void main()
 {
-    gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
+    gl_Position = viewProjection * model * vec4(aPos, 0.0, 1.0);
 }
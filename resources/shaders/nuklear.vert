@@ -6,10 +6,16 @@ layout(location = 2) in vec4 Color;
 out vec2 Frag_UV;
 out vec4 Frag_Color;
 
-uniform mat4 projection;
+layout (std140) uniform Frame {
+    mat4 viewProjection;
+    mat4 screenProjection;
+    vec4 resolution;
+    vec4 internalResolution;
+    float time;
+};
 
 void main() {
     Frag_UV = TexCoord;
     Frag_Color = Color;
-    gl_Position = projection * vec4(Position.xy, 0, 1);
+    gl_Position = screenProjection * vec4(Position.xy, 0, 1);
 }
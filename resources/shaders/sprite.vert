@@ -1,15 +1,19 @@
 #version 330 core
-layout (location = 0) in vec2 aPos;
-layout (location = 1) in vec2 aTexCoords;
+layout (location = 0) in vec2 aPos;        // world space, built by RenderQueue
+layout (location = 1) in vec2 aTexCoords;  // final uv in the (atlas) texture
 
 out vec2 TexCoords;
 
-uniform mat4 model;
-uniform mat4 projection;
-uniform vec4 uvRect;
+layout (std140) uniform Frame {
+    mat4 viewProjection;
+    mat4 screenProjection;
+    vec4 resolution;
+    vec4 internalResolution;
+    float time;
+};
 
 void main()
 {
-    TexCoords = uvRect.xy + aTexCoords * uvRect.zw;
-    gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
+    TexCoords = aTexCoords;
+    gl_Position = viewProjection * vec4(aPos, 0.0, 1.0);
 }
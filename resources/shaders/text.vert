@@ -2,10 +2,19 @@
 layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
 out vec2 TexCoords;
 
-uniform mat4 projection;
+layout (std140) uniform Frame {
+    mat4 viewProjection;
+    mat4 screenProjection;
+    vec4 resolution;
+    vec4 internalResolution;
+    float time;
+};
+
+// World-space text (debug labels) follows the camera; the rest is screen space
+uniform bool worldSpace;
 
 void main()
 {
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+    gl_Position = (worldSpace ? viewProjection : screenProjection) * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
 }